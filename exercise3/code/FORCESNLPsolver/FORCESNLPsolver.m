@@ -2,9 +2,23 @@
 %
 %   OUTPUT = FORCESNLPsolver(PARAMS) solves a multistage problem
 %   subject to the parameters supplied in the following struct:
-%       PARAMS.x0 - column vector of length 600
+%       PARAMS.x0 - column vector of length 600, or 6 x 100 matrix of stages
 %       PARAMS.xinit - column vector of length 4
 %       PARAMS.xfinal - column vector of length 2
+%       PARAMS.N - active horizon, at most 100 (optional, default 100)
+%           the stages behind it are masked, every solve still runs 100
+%       PARAMS.timelimit - wall clock time limit in seconds (optional)
+%       PARAMS.rti - number of real-time iterations (optional)
+%       PARAMS.weights - objective weights [a b1 b2] of -a*y + b1*F^2 + b2*s^2
+%           (optional, default [100 0.1 0.01])
+%       PARAMS.stacked - nonzero to return OUTPUT as one 6 x N matrix with
+%           stage k in column k instead of a struct (optional)
+%
+%   The optional fields, x0 as a matrix and the LOG output are read by the
+%   MEX function compiled from FORCESNLPsolver/interface/FORCESNLPsolver_mex.c
+%   and by the Octave oct-file. The MEX function that FORCES_NLP generates
+%   ignores them: it needs x0 as a vector, solves on all 100 stages and
+%   always returns OUTPUT as a struct.
 %
 %   OUTPUT returns the values of the last iteration of the solver where
 %       OUTPUT.x001 - column vector of size 6
@@ -111,9 +125,11 @@
 %   [OUTPUT, EXITFLAG] = FORCESNLPsolver(PARAMS) returns additionally
 %   the integer EXITFLAG indicating the state of the solution with 
 %       1 - OPTIMAL solution has been found (subject to desired accuracy)
+%       2 - PARAMS.rti iterations done, OUTPUT is the last iterate
 %       0 - Timeout - maximum number of iterations reached
 %      -6 - NaN or INF occured during evaluation of functions and derivatives. Please check your initial guess.
 %      -7 - Method could not progress. Problem may be infeasible. Run FORCESdiagnostics on your problem to check for most common errors in the formulation.
+%     -20 - PARAMS.timelimit reached, OUTPUT is the most feasible iterate
 %    -100 - License error
 %
 %   [OUTPUT, EXITFLAG, INFO] = FORCESNLPsolver(PARAMS) returns 
@@ -128,4 +144,15 @@
 %       INFO.solvetime - Time needed for solve (wall clock time)
 %       INFO.fevalstime - Time needed for function evaluations (wall clock time)
 %
+%   [OUTPUT, EXITFLAG, INFO, LOG] = FORCESNLPsolver(PARAMS) returns 
+%   additionally the log of the solve, one row per iteration (step 0 is
+%   the initial guess, line search trials are left out) and a last row per
+%   solve for its result, whose step is INFO.it, with the columns
+%       [solve step done exitflag time pobj res_eq res_ineq]
+%
+%   Under Octave the same function is provided by FORCESNLPsolver.oct, built
+%   from FORCESNLPsolver/interface/FORCESNLPsolver_oct.cc by running
+%   python FORCESNLPsolver/interface/FORCESNLPsolver_build.py oct
+%   (needs the solver source and mkoctfile, Octave 4.4 or newer).
+%
 % See also COPYING
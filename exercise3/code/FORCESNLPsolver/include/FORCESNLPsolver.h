@@ -34,6 +34,15 @@ typedef double FORCESNLPsolver_float;
 
 typedef double FORCESNLPsolverinterface_float;
 
+/* data type of the stage models, single precision if 
+ * FORCESNLPsolver_SINGLE_PRECISION_MODELS is defined. The solver and its 
+ * interfaces always work in FORCESNLPsolver_float. */
+#ifdef FORCESNLPsolver_SINGLE_PRECISION_MODELS
+typedef float FORCESNLPsolver_stage_float;
+#else
+typedef double FORCESNLPsolver_stage_float;
+#endif
+
 #ifndef __SOLVER_STANDARD_TYPES__
 #define __SOLVER_STANDARD_TYPES__
 
@@ -109,6 +118,62 @@ typedef long long int solver_int64_default;
 #define FORCESNLPsolver_SET_ACC_KKTCOMPL	(FORCESNLPsolver_float)(1E-06)
 
 
+/* cache stage evaluations at unchanged primal points */
+#ifndef FORCESNLPsolver_FEVAL_CACHE
+#define FORCESNLPsolver_FEVAL_CACHE        (1)
+#endif
+
+/* write the exact Hessian of the stage Lagrangian f + y'*c + l'*h to hess. 
+ * Only used by solvers generated with exact Hessians, the default solver 
+ * approximates the Hessian with BFGS and ignores hess. */
+#ifndef FORCESNLPsolver_EXACT_HESSIAN
+#define FORCESNLPsolver_EXACT_HESSIAN      (0)
+#endif
+
+/* set to 1 if the solver was generated with thread safe storage 
+ * (codeoptions.threadSafeStorage), otherwise FORCESNLPsolver_context_solve 
+ * runs one solve at a time */
+#ifndef FORCESNLPsolver_THREADSAFE_STORAGE
+#define FORCESNLPsolver_THREADSAFE_STORAGE (0)
+#endif
+
+/* default distance of the warm start database within which stored 
+ * solutions are used, in keys scaled to the ranges of the bounds */
+#ifndef FORCESNLPsolver_WARMSTART_RADIUS
+#define FORCESNLPsolver_WARMSTART_RADIUS   (0.05)
+#endif
+
+/* distance to a bound within which the tangential predictor treats a 
+ * constraint as active */
+#ifndef FORCESNLPsolver_PREDICTOR_TOL
+#define FORCESNLPsolver_PREDICTOR_TOL      (1E-04)
+#endif
+
+/* default largest difference between the first inputs of neighbouring 
+ * grid points of an explicit MPC table that are interpolated, relative 
+ * to the range of the input bounds */
+#ifndef FORCESNLPsolver_TABLE_SPREAD
+#define FORCESNLPsolver_TABLE_SPREAD       (0.25)
+#endif
+
+/* once a start of a multi-start solve converged, the others are cancelled 
+ * when they ran 1 + FORCESNLPsolver_MULTISTART_GRACE times as long, 0 for 
+ * no limit. Time spent waiting for the solver does not count. */
+#ifndef FORCESNLPsolver_MULTISTART_GRACE
+#define FORCESNLPsolver_MULTISTART_GRACE   (1.0)
+#endif
+
+/* largest number of starts of a multi-start solve */
+#ifndef FORCESNLPsolver_MULTISTART_MAX
+#define FORCESNLPsolver_MULTISTART_MAX     (16)
+#endif
+
+/* number of records a solve log holds before it overwrites the oldest */
+#ifndef FORCESNLPsolver_LOG_SIZE
+#define FORCESNLPsolver_LOG_SIZE           (512)
+#endif
+
+
 /* RETURN CODES----------------------------------------------------------*/
 /* solver has converged within desired accuracy */
 #define FORCESNLPsolver_OPTIMAL      (1)
@@ -125,11 +190,72 @@ typedef long long int solver_int64_default;
 /* no progress in method possible */
 #define FORCESNLPsolver_NOPROGRESS   (-7)
 
+/* The three codes below are returned by contexts only. A context stops a 
+ * solve by handing NaN to the solver, which then returns 
+ * FORCESNLPsolver_BADFUNCEVAL; the context replaces that exitflag and the 
+ * output of the solver. */
+
+/* stopped after the requested number of real-time iterations, the output 
+ * holds the last accepted iterate */
+#define FORCESNLPsolver_RTI          (2)
+
+/* time limit reached, the output holds the most feasible accepted iterate */
+#define FORCESNLPsolver_DEADLINE     (-20)
+
+/* cancelled by the cancel function of the context, e.g. because another 
+ * start of a multi-start solve found a better solution, the output holds 
+ * the last accepted iterate */
+#define FORCESNLPsolver_CANCELLED    (-21)
+
+/* out of memory (batch solves) */
+#define FORCESNLPsolver_NOMEMORY     (-30)
+
 /* licensing error - solver not valid on this machine */
 #define FORCESNLPsolver_LICENSE_ERROR  (-100)
 
 
 
+/* PROBLEM DIMENSIONS ---------------------------------------------------*/
+/* number of stages, i.e. the maximum horizon and the number of stages 
+ * every solve runs (see _set_horizon) */
+#define FORCESNLPsolver_N                  (100)
+
+/* number of variables per stage */
+#define FORCESNLPsolver_NVAR               (6)
+
+/* number of equality constraints (dynamics) per stage */
+#define FORCESNLPsolver_NEQ                (4)
+
+/* number of nonlinear inequality constraints per stage */
+#define FORCESNLPsolver_NH                 (2)
+
+/* number of runtime parameters per stage */
+#define FORCESNLPsolver_NPAR               (0)
+
+/* weights of the objective -a*y + b1*F^2 + b2*s^2 the stage models were 
+ * generated with, the default of every context (see _context_set_weights) */
+#define FORCESNLPsolver_WEIGHT_A           (100.)
+#define FORCESNLPsolver_WEIGHT_B1          (0.1)
+#define FORCESNLPsolver_WEIGHT_B2          (0.01)
+
+/* number of stages evaluated at once by the SIMD stage kernel, 
+ * define as 1 to use the scalar kernel only. The kernel only serves 
+ * callers of _casadi2forces_allstages: the solver evaluates one stage 
+ * at a time through _casadi2forces, which always runs the scalar kernel, 
+ * so the evaluations of a solve do not get faster with it. */
+#ifndef FORCESNLPsolver_SIMD_WIDTH
+#if defined(__AVX512F__) && defined(FORCESNLPsolver_SINGLE_PRECISION_MODELS)
+#define FORCESNLPsolver_SIMD_WIDTH         (16)
+#elif defined(__AVX512F__) || (defined(__AVX__) && defined(FORCESNLPsolver_SINGLE_PRECISION_MODELS))
+#define FORCESNLPsolver_SIMD_WIDTH         (8)
+#elif defined(__AVX__)
+#define FORCESNLPsolver_SIMD_WIDTH         (4)
+#else
+#define FORCESNLPsolver_SIMD_WIDTH         (1)
+#endif
+#endif
+
+
 /* PARAMETERS -----------------------------------------------------------*/
 /* fill this with data before calling the solver! */
 typedef struct FORCESNLPsolver_params
@@ -523,6 +649,32 @@ typedef struct FORCESNLPsolver_info
 
 
 
+/* STAGE EVALUATION CACHE -----------------------------------------------*/
+/* outputs of the last evaluation of one stage, in CasADi sparse format */
+typedef struct FORCESNLPsolver_stage_cache
+{
+    /* primal vars and parameters of the cached evaluation */
+    FORCESNLPsolver_float z[FORCESNLPsolver_NVAR];
+    FORCESNLPsolver_float p[FORCESNLPsolver_NPAR > 0 ? FORCESNLPsolver_NPAR : 1];
+
+    /* cached outputs: 0 none, 1 values, 2 values and gradients of f and h, 3 all */
+    solver_int32_default level;
+
+    /* sparse outputs, in the precision of the stage models */
+    FORCESNLPsolver_stage_float f;
+    FORCESNLPsolver_stage_float nabla_f[3];
+    FORCESNLPsolver_stage_float h[2];
+    FORCESNLPsolver_stage_float nabla_h[4];
+    FORCESNLPsolver_stage_float c[4];
+    FORCESNLPsolver_stage_float nabla_c[16];
+
+    /* number of evaluations served from and missing the cache */
+    solver_int64_default hits;
+    solver_int64_default misses;
+
+} FORCESNLPsolver_stage_cache;
+
+
 /* SOLVER FUNCTION DEFINITION -------------------------------------------*/
 /* examine exitflag before using the result! */
 #ifdef __cplusplus
@@ -534,6 +686,692 @@ typedef void (*FORCESNLPsolver_extfunc)(FORCESNLPsolver_float*, FORCESNLPsolver_
 extern solver_int32_default FORCESNLPsolver_solve(FORCESNLPsolver_params *params, FORCESNLPsolver_output *output, FORCESNLPsolver_info *info, FILE *fs, FORCESNLPsolver_extfunc FORCESNLPsolver_evalextfunctions);	
 
 
+/* STAGE EVALUATION -----------------------------------------------------*/
+/* evaluates a single stage, called by the solver stage by stage. Only 
+ * the stage's own x is passed, so these evaluations cannot be spread 
+ * over threads or SIMD lanes: they run serially on the scalar kernel, 
+ * see _allstages. */
+extern void FORCESNLPsolver_casadi2forces(FORCESNLPsolver_float *x, FORCESNLPsolver_float *y, FORCESNLPsolver_float *l, FORCESNLPsolver_float *p, FORCESNLPsolver_float *f, FORCESNLPsolver_float *nabla_f, FORCESNLPsolver_float *c, FORCESNLPsolver_float *nabla_c, FORCESNLPsolver_float *h, FORCESNLPsolver_float *nabla_h, FORCESNLPsolver_float *hess, solver_int32_default stage);
+
+/* evaluates all stages in one call, FORCESNLPsolver_SIMD_WIDTH stages 
+ * at a time. The solver does not call it; it is for callers that hold a 
+ * complete trajectory. Inputs and outputs are 
+ * stage-strided, i.e. stage k reads x[k*NVAR], y[k*NEQ], l[k*NH], p[k*NPAR] and writes
+ * f[k], nabla_f[k*NVAR], c[k*NEQ], nabla_c[k*NEQ*NVAR], h[k*NH],
+ * nabla_h[k*NH*NVAR] and hess[k*NVAR*NVAR]. Matrices are column major.
+ * Every output may be NULL. The terminal stage has no dynamics, its blocks
+ * of c and nabla_c are left untouched. Only structural nonzeros are 
+ * written, clear the buffers once with _allstages_clear before first use. */
+extern void FORCESNLPsolver_casadi2forces_allstages(FORCESNLPsolver_float *x, FORCESNLPsolver_float *y, FORCESNLPsolver_float *l, FORCESNLPsolver_float *p, FORCESNLPsolver_float *f, FORCESNLPsolver_float *nabla_f, FORCESNLPsolver_float *c, FORCESNLPsolver_float *nabla_c, FORCESNLPsolver_float *h, FORCESNLPsolver_float *nabla_h, FORCESNLPsolver_float *hess);
+
+/* fixed-cost horizon masking: sets the active horizon 1 <= N <= 
+ * FORCESNLPsolver_N of the following solves and returns it (out of range 
+ * values are clamped). Stage N-1 becomes the terminal stage and it and 
+ * all later stages are masked by keeping their state constant, so that 
+ * the final condition applies to stage N-1. Outputs behind the active 
+ * horizon repeat its final state. Applies to the current context. The 
+ * solver still factors and the callback still evaluates all 
+ * FORCESNLPsolver_N stages in every iteration: masking changes the 
+ * problem, not the cost of an iteration. */
+extern solver_int32_default FORCESNLPsolver_casadi2forces_set_horizon(solver_int32_default N);
+
+/* compares the constraints of all stages at the primal point x (and 
+ * parameters p, may be NULL) evaluated by the stage models with the double 
+ * precision reference. err_eq and err_ineq return the largest absolute 
+ * error of the dynamics and of the inequalities. Returns 1 if both are 
+ * within FORCESNLPsolver_SET_ACC_RESEQ/_RESINEQ, i.e. if the solver can 
+ * reach its tolerances with the single precision models, 0 otherwise. 
+ * Always exact in double precision builds. */
+extern solver_int32_default FORCESNLPsolver_casadi2forces_precision(FORCESNLPsolver_float *x, FORCESNLPsolver_float *p, FORCESNLPsolver_float *err_eq, FORCESNLPsolver_float *err_ineq);
+
+/* total hits and misses of the stage evaluation cache of the current 
+ * context. A hit returns the stored outputs of a stage evaluated before 
+ * at the same z and p without calling the model. */
+extern void FORCESNLPsolver_casadi2forces_cache_stats(solver_int64_default *hits, solver_int64_default *misses);
+
+/* empties the stage evaluation cache of the current context */
+extern void FORCESNLPsolver_casadi2forces_cache_reset(void);
+
+/* clears the stage-strided dense buffers of _allstages, NULL is skipped */
+extern void FORCESNLPsolver_casadi2forces_allstages_clear(FORCESNLPsolver_float *nabla_f, FORCESNLPsolver_float *c, FORCESNLPsolver_float *nabla_c, FORCESNLPsolver_float *h, FORCESNLPsolver_float *nabla_h, FORCESNLPsolver_float *hess);
+
+/* bounds lb <= z <= ub and hl <= h(z) <= hu of every stage, hu = 1e30 
+ * stands for no bound */
+extern const FORCESNLPsolver_float FORCESNLPsolver_lb[FORCESNLPsolver_NVAR];
+extern const FORCESNLPsolver_float FORCESNLPsolver_ub[FORCESNLPsolver_NVAR];
+extern const FORCESNLPsolver_float FORCESNLPsolver_hl[FORCESNLPsolver_NH];
+extern const FORCESNLPsolver_float FORCESNLPsolver_hu[FORCESNLPsolver_NH];
+
+
+
+/* ITERATE MONITOR ------------------------------------------------------*/
+/* follows the iterates of a solve through the stage evaluations, which 
+ * the solver runs stage by stage for every new primal point. Line search 
+ * trials are evaluated without derivatives, so a complete evaluation with 
+ * derivatives at a new point is taken as an accepted iterate. A solve is 
+ * stopped by making the next evaluation return NaN. */
+typedef struct FORCESNLPsolver_monitor
+{
+    /* wall clock time at which the solve is stopped, 0 for none */
+    FORCESNLPsolver_float deadline;
+
+    /* wall clock time at which the solve got the solver, after waiting for 
+     * the lock of FORCESNLPsolver_context_solve */
+    FORCESNLPsolver_float start;
+
+    /* number of accepted iterates after which the solve is stopped, 0 for 
+     * none */
+    solver_int32_default maxit;
+
+    /* accepted iterates so far, the initial guess counts as 0, -1 before it */
+    solver_int32_default it;
+
+    /* next stage of the running evaluation, -1 if none is running or the 
+     * stages were not evaluated in order */
+    solver_int32_default next;
+
+    /* set while every stage of the running evaluation computed derivatives */
+    solver_int32_default derivatives;
+
+    /* FORCESNLPsolver_RTI, _DEADLINE or _CANCELLED once the solve was 
+     * stopped */
+    solver_int32_default stopped;
+
+    /* point of the running evaluation, its objective, residuals and the 
+     * dynamics of its previous stage */
+    FORCESNLPsolver_float x[FORCESNLPsolver_N*FORCESNLPsolver_NVAR];
+    FORCESNLPsolver_float pobj;
+    FORCESNLPsolver_float res_eq;
+    FORCESNLPsolver_float res_ineq;
+    FORCESNLPsolver_float c[FORCESNLPsolver_NEQ];
+
+    /* last accepted iterate, its objective and residuals, valid if it >= 0 */
+    FORCESNLPsolver_float iterate[FORCESNLPsolver_N*FORCESNLPsolver_NVAR];
+    FORCESNLPsolver_float iterate_pobj;
+    FORCESNLPsolver_float iterate_res_eq;
+    FORCESNLPsolver_float iterate_res_ineq;
+
+    /* most feasible accepted iterate, valid if nbest > 0 */
+    FORCESNLPsolver_float best[FORCESNLPsolver_N*FORCESNLPsolver_NVAR];
+    FORCESNLPsolver_float best_res_eq;
+    FORCESNLPsolver_float best_res_ineq;
+    solver_int32_default nbest;
+
+} FORCESNLPsolver_monitor;
+
+
+/* decides before every evaluation of the stages whether to cancel a 
+ * solve, returns 1 to cancel. Called once the first iterate was accepted, 
+ * monitor->iterate holds the last one. Called from the thread running the 
+ * solve. */
+typedef solver_int32_default (*FORCESNLPsolver_cancelfunc)(void *data, const FORCESNLPsolver_monitor *monitor);
+
+
+/* SOLVE LOG ------------------------------------------------------------*/
+/* one entry of a solve log: an accepted iterate of a solve, one per 
+ * iteration of the solver, or the result of a solve. Line search trials 
+ * are not logged. */
+typedef struct FORCESNLPsolver_log_record
+{
+    /* number of the solve since the log was initialized, from 1 */
+    solver_int32_default solve;
+
+    /* iteration of the accepted iterate, 0 for the initial guess; info.it 
+     * for the result, which equals the step of the last iterate */
+    solver_int32_default step;
+
+    /* 1 for the result of the solve, 0 otherwise */
+    solver_int32_default done;
+
+    /* exitflag of the solve, 0 unless done */
+    solver_int32_default exitflag;
+
+    /* wall clock time since the start of the solve [s] */
+    FORCESNLPsolver_float time;
+
+    /* objective and largest residuals of equalities and inequalities */
+    FORCESNLPsolver_float pobj;
+    FORCESNLPsolver_float res_eq;
+    FORCESNLPsolver_float res_ineq;
+
+} FORCESNLPsolver_log_record;
+
+/* ring buffer of log records. Filled by the solves of every context whose 
+ * log points to it, and emptied by FORCESNLPsolver_log_drain; neither is 
+ * synchronized, so drain between solves or from the solving thread. */
+typedef struct FORCESNLPsolver_log
+{
+    FORCESNLPsolver_log_record record[FORCESNLPsolver_LOG_SIZE];
+
+    /* oldest record and number of records held */
+    solver_int32_default first;
+    solver_int32_default count;
+
+    /* records overwritten before they were drained */
+    solver_int32_default dropped;
+
+    /* solves logged so far */
+    solver_int32_default solves;
+
+} FORCESNLPsolver_log;
+
+/* length of a line written by FORCESNLPsolver_log_format */
+#define FORCESNLPsolver_LOG_LINE           (96)
+
+/* device the text output of the solver can be discarded to when a log 
+ * takes its place */
+#if defined(_WIN32)
+#define FORCESNLPsolver_NULL_DEVICE        "NUL"
+#else
+#define FORCESNLPsolver_NULL_DEVICE        "/dev/null"
+#endif
+
+/* empties a log and restarts its count of solves */
+extern void FORCESNLPsolver_log_init(FORCESNLPsolver_log *log);
+
+/* appends a record, overwriting the oldest one if the log is full */
+extern void FORCESNLPsolver_log_append(FORCESNLPsolver_log *log, const FORCESNLPsolver_log_record *record);
+
+/* moves the oldest records of a log, at most max, to records and returns 
+ * their number */
+extern solver_int32_default FORCESNLPsolver_log_drain(FORCESNLPsolver_log *log, FORCESNLPsolver_log_record *records, solver_int32_default max);
+
+/* writes a record as one line of text, terminated by a newline, to line 
+ * of length FORCESNLPsolver_LOG_LINE. A NULL record gives the header of 
+ * the columns. */
+extern void FORCESNLPsolver_log_format(const FORCESNLPsolver_log_record *record, char *line);
+
+
+/* SOLVER CONTEXT -------------------------------------------------------*/
+/* everything that belongs to one problem instance. Initialize with 
+ * FORCESNLPsolver_context_init, fill params and call 
+ * FORCESNLPsolver_context_solve. Different contexts can be solved from 
+ * different threads at the same time. */
+typedef struct FORCESNLPsolver_context
+{
+    /* active horizon, see FORCESNLPsolver_context_set_horizon */
+    solver_int32_default horizon;
+
+    /* objective weights [a b1 b2], see FORCESNLPsolver_context_set_weights */
+    FORCESNLPsolver_float weights[3];
+
+    /* limits of every solve, see FORCESNLPsolver_context_set_limits */
+    FORCESNLPsolver_float timelimit;
+    solver_int32_default rti;
+
+    /* cancel function of every solve and its data, NULL for none */
+    FORCESNLPsolver_cancelfunc cancel;
+    void *cancel_data;
+
+    /* log of every solve, NULL for none */
+    FORCESNLPsolver_log *log;
+
+    /* solver parameters, outputs and info of the last solve */
+    FORCESNLPsolver_params params;
+    FORCESNLPsolver_output output;
+    FORCESNLPsolver_info info;
+
+    /* stage evaluation cache */
+    FORCESNLPsolver_stage_cache cache[FORCESNLPsolver_N];
+
+    /* iterates of the running solve */
+    FORCESNLPsolver_monitor monitor;
+
+} FORCESNLPsolver_context;
+
+/* prepares a context for its first solve */
+extern void FORCESNLPsolver_context_init(FORCESNLPsolver_context *ctx);
+
+/* solves the problem in ctx->params, the result is stored in ctx->output 
+ * and ctx->info. Thread safe, but solves of different contexts only run 
+ * concurrently if FORCESNLPsolver_THREADSAFE_STORAGE is set. */
+extern solver_int32_default FORCESNLPsolver_context_solve(FORCESNLPsolver_context *ctx, FILE *fs);
+
+/* sets the active horizon of a context, see _casadi2forces_set_horizon */
+extern solver_int32_default FORCESNLPsolver_context_set_horizon(FORCESNLPsolver_context *ctx, solver_int32_default N);
+
+/* sets the objective weights -a*y + b1*F^2 + b2*s^2 of the following 
+ * solves of a context. The stage models keep the weights they were 
+ * generated with (FORCESNLPsolver_WEIGHT_*), the stage evaluation adds 
+ * the difference, which is exact since the objective is linear in them. */
+extern void FORCESNLPsolver_context_set_weights(FORCESNLPsolver_context *ctx, FORCESNLPsolver_float a, FORCESNLPsolver_float b1, FORCESNLPsolver_float b2);
+
+/* limits the following solves of a context to timelimit seconds of wall 
+ * clock time and, in real-time iteration mode, to rti iterations (0 for 
+ * no limit). A solve stopped at the time limit returns 
+ * FORCESNLPsolver_DEADLINE and the iterate with the smallest 
+ * max(res_eq, res_ineq) seen so far, one stopped after rti iterations 
+ * returns FORCESNLPsolver_RTI and its last iterate. Only accepted iterates 
+ * are counted and returned, line search trials are not. info.it, 
+ * info.res_eq and info.res_ineq are those of the returned iterate. */
+extern void FORCESNLPsolver_context_set_limits(FORCESNLPsolver_context *ctx, FORCESNLPsolver_float timelimit, solver_int32_default rti);
+
+/* records the evaluation of a stage with objective f, dynamics c and 
+ * inequalities h at x in the monitor of a context, derivatives is set if 
+ * the solver asked for them. Returns 1 if the solve is to be stopped. 
+ * Called by FORCESNLPsolver_casadi2forces. */
+extern solver_int32_default FORCESNLPsolver_context_monitor(FORCESNLPsolver_context *ctx, const FORCESNLPsolver_float *x, FORCESNLPsolver_stage_float f, const FORCESNLPsolver_stage_float *c, const FORCESNLPsolver_stage_float *h, solver_int32_default derivatives, solver_int32_default stage);
+
+/* the context of the solve running on the calling thread, or the default 
+ * context used by FORCESNLPsolver_solve and the _casadi2forces functions 
+ * when called directly */
+extern FORCESNLPsolver_context *FORCESNLPsolver_context_current(void);
+
+/* monotonic wall clock time in seconds */
+extern FORCESNLPsolver_float FORCESNLPsolver_walltime(void);
+
+
+/* BATCH SOLVE ----------------------------------------------------------*/
+/* throughput of a batch solve */
+typedef struct FORCESNLPsolver_batch_stats
+{
+    /* number of problems and of problems solved to optimality */
+    solver_int32_default nsolves;
+    solver_int32_default noptimal;
+
+    /* number of threads used */
+    solver_int32_default nthreads;
+
+    /* wall clock time of the batch [s] */
+    FORCESNLPsolver_float walltime;
+
+    /* sum of info.solvetime over all problems [s] */
+    FORCESNLPsolver_float solvetime;
+
+    /* throughput, nsolves / walltime */
+    FORCESNLPsolver_float solves_per_second;
+
+} FORCESNLPsolver_batch_stats;
+
+/* solves the n problems params[0..n-1] and stores the results in 
+ * output[i], exitflag[i] and info[i]. exitflag, info and stats may be 
+ * NULL. All problems use the active horizon of the calling thread. 
+ * Returns the number of problems solved to optimality, or 
+ * FORCESNLPsolver_NOMEMORY. The problems are solved one after another 
+ * unless the solver was generated with FORCESNLPsolver_THREADSAFE_STORAGE 
+ * = 1; then they are distributed over nthreads threads (<= 0 uses all 
+ * cores, OpenMP builds only), which is otherwise ignored. */
+extern solver_int32_default FORCESNLPsolver_solve_batch(solver_int32_default n, const FORCESNLPsolver_params *params, FORCESNLPsolver_output *output, solver_int32_default *exitflag, FORCESNLPsolver_info *info, solver_int32_default nthreads, FORCESNLPsolver_batch_stats *stats);
+
+/* same as FORCESNLPsolver_solve_batch for problems stacked in contiguous
+ * arrays, as the Python interface passes them: x0 is n x 600, xinit n x 4,
+ * xfinal n x 2 and the solutions z are n x FORCESNLPsolver_N x
+ * FORCESNLPsolver_NVAR, row-major. */
+extern solver_int32_default FORCESNLPsolver_solve_stacked(solver_int32_default n, const FORCESNLPsolver_float *x0, const FORCESNLPsolver_float *xinit, const FORCESNLPsolver_float *xfinal, FORCESNLPsolver_float *z, solver_int32_default *exitflag, FORCESNLPsolver_info *info, solver_int32_default nthreads, FORCESNLPsolver_batch_stats *stats);
+
+
+/* MULTI-START SOLVE ----------------------------------------------------*/
+/* result of a multi-start solve */
+typedef struct FORCESNLPsolver_multistart_stats
+{
+    /* number of starts, index of the returned one, number of starts 
+     * solved to optimality and cancelled */
+    solver_int32_default nstarts;
+    solver_int32_default best;
+    solver_int32_default noptimal;
+    solver_int32_default ncancelled;
+
+    /* exitflag, iterations and objective of each start */
+    solver_int32_default exitflag[FORCESNLPsolver_MULTISTART_MAX];
+    solver_int32_default it[FORCESNLPsolver_MULTISTART_MAX];
+    FORCESNLPsolver_float pobj[FORCESNLPsolver_MULTISTART_MAX];
+
+    /* number of threads used and wall clock time [s] */
+    solver_int32_default nthreads;
+    FORCESNLPsolver_float walltime;
+
+} FORCESNLPsolver_multistart_stats;
+
+/* solves the problem of a context from nstarts <= 
+ * FORCESNLPsolver_MULTISTART_MAX initial guesses. The starts run one after 
+ * another unless the solver was generated with 
+ * FORCESNLPsolver_THREADSAFE_STORAGE = 1; then they run concurrently on 
+ * nthreads threads (<= 0 uses all cores, OpenMP builds only), which is 
+ * otherwise ignored. x0 holds the guesses one after 
+ * another; if it is NULL, start 0 uses ctx->params.x0 and the others 
+ * FORCESNLPsolver_multistart_guess. Once a start is optimal, the others 
+ * are cancelled when they reach a feasible iterate with a worse 
+ * objective or run out of time, see FORCESNLPsolver_MULTISTART_GRACE, and 
+ * return FORCESNLPsolver_CANCELLED. The optimal start with the smallest objective (or, if none, the 
+ * start with the smallest residuals) is stored in ctx->output and 
+ * ctx->info and its exitflag returned. stats may be NULL. The run time of 
+ * a start is counted from the moment it holds the solver. */
+extern solver_int32_default FORCESNLPsolver_solve_multistart(FORCESNLPsolver_context *ctx, solver_int32_default nstarts, const FORCESNLPsolver_float *x0, solver_int32_default nthreads, FORCESNLPsolver_multistart_stats *stats);
+
+/* initial guess j of n for the problem params on the first horizon 
+ * stages: a straight path from xinit to a point beside the obstacle, the 
+ * points of the n guesses spread around it, with a speed profile that 
+ * depends on j. */
+extern void FORCESNLPsolver_multistart_guess(const FORCESNLPsolver_params *params, solver_int32_default horizon, solver_int32_default j, solver_int32_default n, FORCESNLPsolver_float *x0);
+
+
+/* WEIGHT SWEEP ---------------------------------------------------------*/
+/* result of a sweep over objective weights */
+typedef struct FORCESNLPsolver_sweep_stats
+{
+    /* number of grid points, of converged ones and of solves warm started 
+     * from the previous point */
+    solver_int32_default npoints;
+    solver_int32_default noptimal;
+    solver_int32_default nwarm;
+
+    /* iterations of all solves */
+    solver_int32_default it;
+
+    /* wall clock time of the sweep [s] */
+    FORCESNLPsolver_float walltime;
+
+} FORCESNLPsolver_sweep_stats;
+
+/* solves the problem of a context for every point of the grid of objective 
+ * weights a[0..na-1] x b1[0..nb1-1] x b2[0..nb2-1]. The grid is walked in 
+ * serpentine order, so that consecutive points differ in one weight by one 
+ * grid step, and every solve starts from the solution of the previous 
+ * point if it converged or reached the iteration limit, otherwise from 
+ * ctx->params.x0. If out is not NULL, one line per point is written to it:
+ * 
+ *     a b1 b2 exitflag it solvetime pobj z
+ * 
+ * with z the stages of the active horizon, which can be read with 
+ * MATLAB's load. The weights of the context are restored afterwards, 
+ * ctx->params.x0 is overwritten. Returns the number of converged points, 
+ * stats may be NULL. */
+extern solver_int32_default FORCESNLPsolver_sweep_weights(FORCESNLPsolver_context *ctx, const FORCESNLPsolver_float *a, solver_int32_default na, const FORCESNLPsolver_float *b1, solver_int32_default nb1, const FORCESNLPsolver_float *b2, solver_int32_default nb2, FILE *out, FORCESNLPsolver_sweep_stats *stats);
+
+
+/* MPC DRIVER -----------------------------------------------------------*/
+/* one step of a receding horizon controller */
+typedef struct FORCESNLPsolver_mpc_stats
+{
+    /* exitflag and iterations of the solve */
+    solver_int32_default exitflag;
+    solver_int32_default it;
+
+    /* 1 if the solve was warm started from the previous step */
+    solver_int32_default warm;
+
+    /* wall clock time of the step including the shift [s] and
+     * info.solvetime of the solve [s] */
+    FORCESNLPsolver_float latency;
+    FORCESNLPsolver_float solvetime;
+
+    /* initial state and applied input [F s] */
+    FORCESNLPsolver_float xinit[4];
+    FORCESNLPsolver_float u[2];
+
+} FORCESNLPsolver_mpc_stats;
+
+/* state of a receding horizon controller. Initialize with 
+ * FORCESNLPsolver_mpc_init, then call FORCESNLPsolver_mpc_step once per 
+ * sampling instant. */
+typedef struct FORCESNLPsolver_mpc
+{
+    /* problem solved at each step, ctx.output holds the last solution */
+    FORCESNLPsolver_context ctx;
+
+    /* 1 if ctx.output can warm start the next step */
+    solver_int32_default warm;
+
+    /* initial guess of the steps that are not warm started, all stages, 
+     * NULL for the middle of the bounds */
+    const FORCESNLPsolver_float *guess;
+
+    /* number of steps taken */
+    solver_int32_default steps;
+
+    /* solver printouts, may be NULL */
+    FILE *fs;
+
+} FORCESNLPsolver_mpc;
+
+/* prepares a controller with final condition xfinal on the first horizon 
+ * stages. The first step is cold started from mpc->guess, which is NULL 
+ * for the middle of the bounds. */
+extern void FORCESNLPsolver_mpc_init(FORCESNLPsolver_mpc *mpc, const FORCESNLPsolver_float *xfinal, solver_int32_default horizon);
+
+/* solves the problem for the measured state xinit, warm started from the 
+ * previous solution shifted by one stage. step may be NULL. Returns the 
+ * exitflag; the input to apply is output.x001[0..1] or step->u. */
+extern solver_int32_default FORCESNLPsolver_mpc_step(FORCESNLPsolver_mpc *mpc, const FORCESNLPsolver_float *xinit, FORCESNLPsolver_mpc_stats *step);
+
+/* state xnext after applying input u for one sampling period from state 
+ * x, by the RK4 step of the model */
+extern void FORCESNLPsolver_mpc_simulate(const FORCESNLPsolver_float *x, const FORCESNLPsolver_float *u, FORCESNLPsolver_float *xnext);
+
+/* closed loop simulation of nsteps steps from xinit, the model standing 
+ * in for the plant. steps[0..nsteps-1] may be NULL. Returns the number of 
+ * steps taken, which is less than nsteps if a solve failed without a 
+ * usable iterate. */
+extern solver_int32_default FORCESNLPsolver_mpc_run(FORCESNLPsolver_mpc *mpc, const FORCESNLPsolver_float *xinit, solver_int32_default nsteps, FORCESNLPsolver_mpc_stats *steps);
+
+
+/* ASYNCHRONOUS MPC -----------------------------------------------------*/
+/* receding horizon controller whose steps run on a worker thread, so that 
+ * the caller never waits for a solve. Start with 
+ * FORCESNLPsolver_mpc_async_start and stop with _mpc_async_stop. */
+typedef struct FORCESNLPsolver_mpc_async
+{
+    /* controller, only used by the worker while it runs */
+    FORCESNLPsolver_mpc mpc;
+
+    /* requested step: measured state, final condition and the initial 
+     * guess used if the step is not warm started */
+    FORCESNLPsolver_float xinit[4];
+    FORCESNLPsolver_float xfinal[2];
+    FORCESNLPsolver_float guess[FORCESNLPsolver_N*FORCESNLPsolver_NVAR];
+
+    /* last completed step: its solution, all stages, and statistics */
+    FORCESNLPsolver_float z[FORCESNLPsolver_N*FORCESNLPsolver_NVAR];
+    FORCESNLPsolver_mpc_stats stats;
+
+    /* completed steps and requests dropped because a step was running */
+    solver_int32_default completed;
+    solver_int32_default dropped;
+
+    /* 1 while a step is requested or running, 2 when stopping */
+    solver_int32_default busy;
+
+    /* thread and synchronization, owned by the implementation */
+    void *worker;
+
+} FORCESNLPsolver_mpc_async;
+
+/* prepares the controller as FORCESNLPsolver_mpc_init and starts its 
+ * worker thread. Returns 0, or FORCESNLPsolver_NOMEMORY if the thread 
+ * could not be started. */
+extern solver_int32_default FORCESNLPsolver_mpc_async_start(FORCESNLPsolver_mpc_async *async, const FORCESNLPsolver_float *xfinal, solver_int32_default horizon);
+
+/* requests a step for the measured state xinit and final condition 
+ * xfinal without waiting for it. guess (all stages) is the initial guess 
+ * if the step cannot be warm started, NULL for the middle of the bounds. 
+ * If the previous step still runs, the request is dropped. Copies the 
+ * solution of the last completed step to z and its statistics to step, 
+ * either may be NULL. Returns the number of completed steps; z and step 
+ * are only written if it is positive. Returns FORCESNLPsolver_NOMEMORY if 
+ * the worker is not running, i.e. _mpc_async_start failed or 
+ * _mpc_async_stop was called. */
+extern solver_int32_default FORCESNLPsolver_mpc_async_step(FORCESNLPsolver_mpc_async *async, const FORCESNLPsolver_float *xinit, const FORCESNLPsolver_float *xfinal, const FORCESNLPsolver_float *guess, FORCESNLPsolver_float *z, FORCESNLPsolver_mpc_stats *step);
+
+/* waits until the requested step is completed. Returns 0, or 
+ * FORCESNLPsolver_NOMEMORY if the worker is not running. */
+extern solver_int32_default FORCESNLPsolver_mpc_async_wait(FORCESNLPsolver_mpc_async *async);
+
+/* waits for the running step and stops the worker thread */
+extern void FORCESNLPsolver_mpc_async_stop(FORCESNLPsolver_mpc_async *async);
+
+
+/* WARM START DATABASE --------------------------------------------------*/
+/* length of the key of a stored solution, xinit and xfinal */
+#define FORCESNLPsolver_WARMSTART_NKEY     (6)
+
+/* stored solution, also the record of the database file */
+typedef struct FORCESNLPsolver_warmstart_entry
+{
+    /* xinit and xfinal, each divided by the range of its bounds */
+    FORCESNLPsolver_float key[FORCESNLPsolver_WARMSTART_NKEY];
+
+    /* solution, all stages */
+    FORCESNLPsolver_float x[FORCESNLPsolver_N*FORCESNLPsolver_NVAR];
+
+} FORCESNLPsolver_warmstart_entry;
+
+/* converged solutions indexed by a kd-tree over their keys. Not thread 
+ * safe, use one database per thread or a lock. */
+typedef struct FORCESNLPsolver_warmstart
+{
+    /* stored solutions, count <= capacity */
+    FORCESNLPsolver_warmstart_entry *entries;
+    solver_int32_default count;
+    solver_int32_default capacity;
+
+    /* lookups further away than this return no solution, 0 for no limit */
+    FORCESNLPsolver_float radius;
+
+    /* number of lookups and of lookups that returned a solution */
+    solver_int64_default lookups;
+    solver_int64_default hits;
+
+    /* last use of every entry for the LRU replacement */
+    solver_int64_default *used;
+    solver_int64_default clock;
+
+    /* kd-tree over the first ntree entries, entries stored since then */
+    struct FORCESNLPsolver_warmstart_node *tree;
+    solver_int32_default ntree;
+    solver_int32_default *version;
+    solver_int32_default *pending;
+    solver_int32_default npending;
+
+    /* loaded file, entries point into it until they are made writable */
+    void *map;
+    size_t maplength;
+    solver_int32_default writable;
+
+} FORCESNLPsolver_warmstart;
+
+/* prepares an empty database for at most capacity solutions. Returns 0 or 
+ * FORCESNLPsolver_NOMEMORY. */
+extern solver_int32_default FORCESNLPsolver_warmstart_init(FORCESNLPsolver_warmstart *db, solver_int32_default capacity);
+
+/* frees the memory of a database */
+extern void FORCESNLPsolver_warmstart_free(FORCESNLPsolver_warmstart *db);
+
+/* stores the solution output of the problem params, replacing the least 
+ * recently used solution if the database is full and the solution of the 
+ * same key if there is one. Returns the slot or FORCESNLPsolver_NOMEMORY. */
+extern solver_int32_default FORCESNLPsolver_warmstart_insert(FORCESNLPsolver_warmstart *db, const FORCESNLPsolver_params *params, const FORCESNLPsolver_output *output);
+
+/* sets params->x0 to the stored solution nearest to params->xinit and 
+ * params->xfinal, or to the inverse distance weighted mean of the k 
+ * nearest within the radius. Returns the number of solutions used, 0 if 
+ * none is within the radius, in which case x0 is left unchanged. */
+extern solver_int32_default FORCESNLPsolver_warmstart_lookup(FORCESNLPsolver_warmstart *db, FORCESNLPsolver_params *params, solver_int32_default k);
+
+/* writes a database to a file, returns 0 on success */
+extern solver_int32_default FORCESNLPsolver_warmstart_save(const FORCESNLPsolver_warmstart *db, const char *path);
+
+/* replaces the content of an initialized database by the file written 
+ * with _save, up to its capacity. The file is memory-mapped where 
+ * possible. Returns 0 on success; on failure the database is left as it 
+ * was. */
+extern solver_int32_default FORCESNLPsolver_warmstart_load(FORCESNLPsolver_warmstart *db, const char *path);
+
+/* number of lookups and of lookups that returned a solution */
+extern void FORCESNLPsolver_warmstart_stats(const FORCESNLPsolver_warmstart *db, solver_int64_default *lookups, solver_int64_default *hits);
+
+
+/* TANGENTIAL PREDICTOR -------------------------------------------------*/
+/* first order sensitivity of a converged solution with respect to xinit */
+typedef struct FORCESNLPsolver_predictor
+{
+    /* 1 after a successful FORCESNLPsolver_predictor_update */
+    solver_int32_default valid;
+
+    /* active horizon, solution and xinit of the linearization */
+    solver_int32_default horizon;
+    FORCESNLPsolver_float z[FORCESNLPsolver_N*FORCESNLPsolver_NVAR];
+    FORCESNLPsolver_float xinit[4];
+
+    /* dz/dxinit, 4 entries per variable */
+    FORCESNLPsolver_float dz[FORCESNLPsolver_N*FORCESNLPsolver_NVAR*4];
+
+    /* inequalities and their gradients in x and y at z */
+    FORCESNLPsolver_float h[FORCESNLPsolver_N*FORCESNLPsolver_NH];
+    FORCESNLPsolver_float dh[FORCESNLPsolver_N*FORCESNLPsolver_NH*2];
+
+    /* constraints held active, and how many of them were dropped as 
+     * linearly dependent on others */
+    solver_int32_default nactive;
+    solver_int32_default ndropped;
+
+} FORCESNLPsolver_predictor;
+
+/* linearizes the problem at the solution in ctx->output (for 
+ * ctx->params.xinit and the active horizon of ctx) and computes its 
+ * sensitivity. Call after a converged solve. Returns 0 or 
+ * FORCESNLPsolver_NOMEMORY. */
+extern solver_int32_default FORCESNLPsolver_predictor_update(FORCESNLPsolver_predictor *pred, const FORCESNLPsolver_context *ctx);
+
+/* writes the first order prediction of the solution for the initial state 
+ * xinit to output. Returns 0, or 1 if the prediction leaves the active set 
+ * of the linearization (or there is none) and a full solve is needed; the 
+ * prediction is still written then and makes a good initial guess. */
+extern solver_int32_default FORCESNLPsolver_predictor_predict(const FORCESNLPsolver_predictor *pred, const FORCESNLPsolver_float *xinit, FORCESNLPsolver_output *output);
+
+
+/* EXPLICIT MPC TABLE ---------------------------------------------------*/
+/* solutions on a regular grid of initial states, for one final condition */
+typedef struct FORCESNLPsolver_table
+{
+    /* grid: n[i] >= 2 points from lo[i] to hi[i] in xinit[i], xinit[0] 
+     * running fastest */
+    solver_int32_default n[4];
+    FORCESNLPsolver_float lo[4];
+    FORCESNLPsolver_float hi[4];
+    solver_int32_default npoints;
+
+    /* final condition of all solutions */
+    FORCESNLPsolver_float xfinal[2];
+
+    /* largest interpolated difference of first inputs, relative to the 
+     * range of their bounds, 0 for no limit */
+    FORCESNLPsolver_float spread;
+
+    /* per grid point: 1 if solved to optimality, first inputs [F s] and 
+     * the complete solution (NULL if not stored) */
+    solver_int8_unsigned *status;
+    float *u;
+    float *x;
+
+} FORCESNLPsolver_table;
+
+/* solves the problem for the final condition xfinal at every point of the 
+ * grid n, lo, hi on nthreads threads (see FORCESNLPsolver_solve_batch, one 
+ * thread without FORCESNLPsolver_THREADSAFE_STORAGE), cold 
+ * started from the middle of the bounds. Grid points that violate the 
+ * inequalities are not solved. Stores the complete solutions if 
+ * trajectories is set. Returns the number of solved grid points or 
+ * FORCESNLPsolver_NOMEMORY. */
+extern solver_int32_default FORCESNLPsolver_table_build(FORCESNLPsolver_table *table, const solver_int32_default *n, const FORCESNLPsolver_float *lo, const FORCESNLPsolver_float *hi, const FORCESNLPsolver_float *xfinal, solver_int32_default trajectories, solver_int32_default nthreads);
+
+/* frees the memory of a table */
+extern void FORCESNLPsolver_table_free(FORCESNLPsolver_table *table);
+
+/* interpolates the first inputs u of the solution for xinit between the 
+ * 16 surrounding grid points, and the complete solution into output if 
+ * output is not NULL and the table stores solutions. Returns 0, or 1 if 
+ * the online solver has to be used: xinit outside the grid, a 
+ * surrounding grid point without solution, inputs that differ by more 
+ * than the spread, or an interpolated solution that violates h. */
+extern solver_int32_default FORCESNLPsolver_table_lookup(const FORCESNLPsolver_table *table, const FORCESNLPsolver_float *xinit, FORCESNLPsolver_float *u, FORCESNLPsolver_output *output);
+
+/* writes a table to a file, returns 0 on success */
+extern solver_int32_default FORCESNLPsolver_table_save(const FORCESNLPsolver_table *table, const char *path);
+
+/* reads a table written by _save, returns 0 on success */
+extern solver_int32_default FORCESNLPsolver_table_load(FORCESNLPsolver_table *table, const char *path);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,10 +27,24 @@ c = new_compiler()
 
 import os
 import sys
+import glob
+import subprocess
 import distutils
 
+# usage: python FORCESNLPsolver_build.py [oct], run from the directory that
+# contains the FORCESNLPsolver folder; with oct, the Octave interface
+# FORCESNLPsolver.oct is built as well
+
 # determine source file
 sourcefile = os.path.join(os.getcwd(),"FORCESNLPsolver","src","FORCESNLPsolver"+".c")
+if not os.path.isfile(sourcefile):
+	sys.exit("FORCESNLPsolver_build.py: the solver source " + sourcefile + " does not exist.\n"
+		"This solver was generated as a binary library only. Regenerate it with the\n"
+		"source code option of FORCES Pro (or copy the generated src folder next to\n"
+		"include and lib) to build it on this platform.")
+
+# model, context and the other functions called back by the solver
+modelfiles = sorted(glob.glob(os.path.join(os.getcwd(),"FORCESNLPsolver_*.c")))
 
 # determine lib file
 if sys.platform.startswith('win'):
@@ -48,15 +62,27 @@ if not os.path.exists(os.path.join(os.getcwd(),"FORCESNLPsolver","lib")):
 objdir = os.path.join(os.getcwd(),"FORCESNLPsolver","obj")
 if isinstance(c,distutils.unixccompiler.UnixCCompiler):
 	#objects = c.compile([sourcefile], output_dir=objdir, extra_preargs=['-O3','-fPIC','-fopenmp','-mavx'])
-	objects = c.compile([sourcefile], output_dir=objdir, extra_preargs=['-O3','-fPIC','-mavx'])
+	objects = c.compile([sourcefile] + modelfiles, output_dir=objdir, include_dirs=[os.getcwd()], extra_preargs=['-O3','-fPIC','-mavx','-pthread'])
 	if sys.platform.startswith('linux'):
-		c.set_libraries(['rt','gomp'])
+		c.set_libraries(['rt','gomp','pthread','m'])
 else:
-	objects = c.compile([sourcefile], output_dir=objdir)
+	objects = c.compile([sourcefile] + modelfiles, output_dir=objdir, include_dirs=[os.getcwd()])
 
 				
 # create libraries
 libdir = os.path.join(os.getcwd(),"FORCESNLPsolver","lib")
-exportsymbols = ["%s_solve" % "FORCESNLPsolver"]
+# the solver, the stage evaluation it is called with and the batch and 
+# context functions of the Python interface
+exportsymbols = ["%s_%s" % ("FORCESNLPsolver", name) for name in ["solve", "casadi2forces", "solve_batch", "solve_stacked", 
+	"context_init", "context_solve", "context_current", "context_set_horizon", "context_set_weights", "context_set_limits"]]
 c.create_static_lib(objects, "FORCESNLPsolver", output_dir=libdir)
-c.link_shared_lib(objects, "FORCESNLPsolver", output_dir=libdir, export_symbols=exportsymbols)
\ No newline at end of file
+c.link_shared_lib(objects, "FORCESNLPsolver", output_dir=libdir, export_symbols=exportsymbols)
+
+# build the Octave interface against the static library
+if 'oct' in sys.argv[1:]:
+	octsource = os.path.join(os.getcwd(),"FORCESNLPsolver","interface","FORCESNLPsolver_oct.cc")
+	octlib = c.library_filename("FORCESNLPsolver", lib_type='static', output_dir=libdir)
+	try:
+		subprocess.check_call(["mkoctfile", "-o", os.path.join(os.getcwd(),"FORCESNLPsolver.oct"), octsource, octlib, "-lpthread"])
+	except OSError:
+		sys.exit("FORCESNLPsolver_build.py: mkoctfile not found, please install the Octave development files (liboctave-dev).")
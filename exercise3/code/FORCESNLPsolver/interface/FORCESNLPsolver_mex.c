@@ -56,14 +56,24 @@ void copyMArrayToC(double *src, double *dest, solver_int32_default dim)
 }
 
 
-extern void FORCESNLPsolver_casadi2forces(FORCESNLPsolver_float *x, FORCESNLPsolver_float *y, FORCESNLPsolver_float *l, FORCESNLPsolver_float *p, FORCESNLPsolver_float *f, FORCESNLPsolver_float *nabla_f, FORCESNLPsolver_float *c, FORCESNLPsolver_float *nabla_c, FORCESNLPsolver_float *h, FORCESNLPsolver_float *nabla_h, FORCESNLPsolver_float *hess, solver_int32_default stage);
-FORCESNLPsolver_extfunc pt2function = &FORCESNLPsolver_casadi2forces;
+/* Some memory for mex-function, kept between calls */
+static FORCESNLPsolver_context context;
+static solver_int32_default context_initialized = 0;
 
+/* log of the solves of one call, it replaces the text output of the 
+ * solver, which goes to the null device */
+static FORCESNLPsolver_log solvelog;
+static FORCESNLPsolver_log_record records[FORCESNLPsolver_LOG_SIZE];
+static FILE *null_stream = NULL;
 
-/* Some memory for mex-function */
-FORCESNLPsolver_params params;
-FORCESNLPsolver_output output;
-FORCESNLPsolver_info info;
+static void close_null_stream(void)
+{
+	if( null_stream != NULL )
+	{
+		fclose(null_stream);
+		null_stream = NULL;
+	}
+}
 
 /* THE mex-function */
 void mexFunction( solver_int32_default nlhs, mxArray *plhs[], solver_int32_default nrhs, const mxArray *prhs[] )  
@@ -78,6 +88,11 @@ void mexFunction( solver_int32_default nlhs, mxArray *plhs[], solver_int32_defau
 	double *pvalue;
 	solver_int32_default i;
 	solver_int32_default exitflag;
+	FORCESNLPsolver_float timelimit;
+	solver_int32_default rti;
+	solver_int32_default stacked;
+	solver_int32_default nrecords;
+	char line[FORCESNLPsolver_LOG_LINE];
 	const solver_int8_default *fname;
 	const solver_int8_default *outputnames[100] = {"x001","x002","x003","x004","x005","x006","x007","x008","x009","x010","x011","x012","x013","x014","x015","x016","x017","x018","x019","x020","x021","x022","x023","x024","x025","x026","x027","x028","x029","x030","x031","x032","x033","x034","x035","x036","x037","x038","x039","x040","x041","x042","x043","x044","x045","x046","x047","x048","x049","x050","x051","x052","x053","x054","x055","x056","x057","x058","x059","x060","x061","x062","x063","x064","x065","x066","x067","x068","x069","x070","x071","x072","x073","x074","x075","x076","x077","x078","x079","x080","x081","x082","x083","x084","x085","x086","x087","x088","x089","x090","x091","x092","x093","x094","x095","x096","x097","x098","x099","x100"};
 	const solver_int8_default *infofields[10] = { "it", "it2opt", "res_eq", "res_ineq",  "rsnorm",  "rcompnorm",  "pobj",  "mu",  "solvetime",  "fevalstime"};
@@ -87,9 +102,9 @@ void mexFunction( solver_int32_default nlhs, mxArray *plhs[], solver_int32_defau
 	{
         mexErrMsgTxt("This function requires exactly 1 input: PARAMS struct.\nType 'help FORCESNLPsolver_mex' for details.");
     }    
-	if (nlhs > 3) 
+	if (nlhs > 4) 
 	{
-        mexErrMsgTxt("This function returns at most 3 outputs.\nType 'help FORCESNLPsolver_mex' for details.");
+        mexErrMsgTxt("This function returns at most 4 outputs.\nType 'help FORCESNLPsolver_mex' for details.");
     }
 
 	/* Check whether params is actually a structure */
@@ -98,6 +113,12 @@ void mexFunction( solver_int32_default nlhs, mxArray *plhs[], solver_int32_defau
 		mexErrMsgTxt("PARAMS must be a structure.");
 	}
 
+	if( !context_initialized )
+	{
+		FORCESNLPsolver_context_init(&context);
+		context_initialized = 1;
+	}
+
 	/* copy parameters into the right location */
 	par = mxGetField(PARAMS, 0, "x0");
 #ifdef MEXARGMUENTCHECKS
@@ -109,12 +130,12 @@ void mexFunction( solver_int32_default nlhs, mxArray *plhs[], solver_int32_defau
     {
     mexErrMsgTxt("PARAMS.x0 must be a double.");
     }
-    if( mxGetM(par) != 600 || mxGetN(par) != 1 ) 
+    if( (mxGetM(par) != 600 || mxGetN(par) != 1) && (mxGetM(par) != 6 || mxGetN(par) != 100) ) 
 	{
-    mexErrMsgTxt("PARAMS.x0 must be of size [600 x 1]");
+    mexErrMsgTxt("PARAMS.x0 must be of size [600 x 1] or [6 x 100]");
     }
 #endif	 
-    copyMArrayToC(mxGetPr(par), params.x0, 600);
+    copyMArrayToC(mxGetPr(par), context.params.x0, 600);
 
 	par = mxGetField(PARAMS, 0, "xinit");
 #ifdef MEXARGMUENTCHECKS
@@ -131,7 +152,7 @@ void mexFunction( solver_int32_default nlhs, mxArray *plhs[], solver_int32_defau
     mexErrMsgTxt("PARAMS.xinit must be of size [4 x 1]");
     }
 #endif	 
-    copyMArrayToC(mxGetPr(par), params.xinit, 4);
+    copyMArrayToC(mxGetPr(par), context.params.xinit, 4);
 
 	par = mxGetField(PARAMS, 0, "xfinal");
 #ifdef MEXARGMUENTCHECKS
@@ -148,436 +169,527 @@ void mexFunction( solver_int32_default nlhs, mxArray *plhs[], solver_int32_defau
     mexErrMsgTxt("PARAMS.xfinal must be of size [2 x 1]");
     }
 #endif	 
-    copyMArrayToC(mxGetPr(par), params.xfinal, 2);
+    copyMArrayToC(mxGetPr(par), context.params.xfinal, 2);
+
+	/* optional active horizon, all stages if not given */
+	par = mxGetField(PARAMS, 0, "N");
+	if( par != NULL )
+	{
+#ifdef MEXARGMUENTCHECKS
+		if( !mxIsNumeric(par) || mxGetNumberOfElements(par) != 1 ) 
+		{
+			mexErrMsgTxt("PARAMS.N must be a scalar.");
+		}
+#endif
+		FORCESNLPsolver_context_set_horizon(&context, (solver_int32_default)mxGetScalar(par));
+	}
+	else
+	{
+		FORCESNLPsolver_context_set_horizon(&context, FORCESNLPsolver_N);
+	}
+
+	/* optional time limit and real-time iterations, no limits if not given */
+	timelimit = 0;
+	rti = 0;
+	par = mxGetField(PARAMS, 0, "timelimit");
+	if( par != NULL )
+	{
+#ifdef MEXARGMUENTCHECKS
+		if( !mxIsNumeric(par) || mxGetNumberOfElements(par) != 1 ) 
+		{
+			mexErrMsgTxt("PARAMS.timelimit must be a scalar.");
+		}
+#endif
+		timelimit = mxGetScalar(par);
+	}
+	par = mxGetField(PARAMS, 0, "rti");
+	if( par != NULL )
+	{
+#ifdef MEXARGMUENTCHECKS
+		if( !mxIsNumeric(par) || mxGetNumberOfElements(par) != 1 ) 
+		{
+			mexErrMsgTxt("PARAMS.rti must be a scalar.");
+		}
+#endif
+		rti = (solver_int32_default)mxGetScalar(par);
+	}
+	FORCESNLPsolver_context_set_limits(&context, timelimit, rti);
+
+	/* optional objective weights [a b1 b2], the generated ones if not given */
+	par = mxGetField(PARAMS, 0, "weights");
+	if( par != NULL )
+	{
+#ifdef MEXARGMUENTCHECKS
+		if( !mxIsDouble(par) || mxGetNumberOfElements(par) != 3 ) 
+		{
+			mexErrMsgTxt("PARAMS.weights must be a double vector of length 3.");
+		}
+#endif
+		FORCESNLPsolver_context_set_weights(&context, mxGetPr(par)[0], mxGetPr(par)[1], mxGetPr(par)[2]);
+	}
+	else
+	{
+		FORCESNLPsolver_context_set_weights(&context, FORCESNLPsolver_WEIGHT_A, FORCESNLPsolver_WEIGHT_B1, FORCESNLPsolver_WEIGHT_B2);
+	}
+
+	/* optional output as one matrix of the stages, a struct if not given */
+	stacked = 0;
+	par = mxGetField(PARAMS, 0, "stacked");
+	if( par != NULL )
+	{
+#ifdef MEXARGMUENTCHECKS
+		if( !mxIsNumeric(par) || mxGetNumberOfElements(par) != 1 ) 
+		{
+			mexErrMsgTxt("PARAMS.stacked must be a scalar.");
+		}
+#endif
+		stacked = mxGetScalar(par) != 0;
+	}
+
+	/* log the solves if they are printed or returned */
+	context.log = FORCESNLPsolver_SET_PRINTLEVEL > 0 || nlhs > 3 ? &solvelog : NULL;
+	FORCESNLPsolver_log_init(&solvelog);
 
 	#if FORCESNLPsolver_SET_PRINTLEVEL > 0
-		/* Prepare file for printfs */
-		/*fp = freopen("stdout_temp","w+",stdout);*/
-        fp = fopen("stdout_temp","w+");
-		if( fp == NULL ) 
+		/* discard the text output of the solver, stdout if that fails */
+		if( null_stream == NULL ) 
 		{
-			mexErrMsgTxt("freopen of stdout did not work.");
+			null_stream = fopen(FORCESNLPsolver_NULL_DEVICE, "w");
+			mexAtExit(close_null_stream);
 		}
-		rewind(fp);
+		fp = null_stream;
 	#endif
 
 	/* call solver */
-	exitflag = FORCESNLPsolver_solve(&params, &output, &info, fp, pt2function);
+	exitflag = FORCESNLPsolver_context_solve(&context, fp);
 
-	/* close stdout */
-	/* fclose(fp); */
+	nrecords = FORCESNLPsolver_log_drain(&solvelog, records, FORCESNLPsolver_LOG_SIZE);
 	
 	#if FORCESNLPsolver_SET_PRINTLEVEL > 0
-		/* Read contents of printfs printed to file */
-		rewind(fp);
-		while( (i = fgetc(fp)) != EOF ) 
+		/* print the log */
+		FORCESNLPsolver_log_format(NULL, line);
+		mexPrintf("%s", line);
+		for( i=0; i<nrecords; i++ ) 
 		{
-			mexPrintf("%c",i);
+			FORCESNLPsolver_log_format(records + i, line);
+			mexPrintf("%s", line);
+		}
+		if( solvelog.dropped > 0 )
+		{
+			mexPrintf("(%d older records dropped)\n", solvelog.dropped);
 		}
-		fclose(fp);
 	#endif
 
 	/* copy output to matlab arrays */
-	plhs[0] = mxCreateStructMatrix(1, 1, 100, outputnames);
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x001, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x001", outvar);
+	if( stacked )
+	{
+		/* the stages of the output are contiguous, column k is stage k */
+		plhs[0] = mxCreateDoubleMatrix(6, context.horizon, mxREAL);
+		copyCArrayToM( context.output.x001, mxGetPr(plhs[0]), 6*context.horizon);
+	}
+	else
+	{
+		plhs[0] = mxCreateStructMatrix(1, 1, 100, outputnames);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x001, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x001", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x002, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x002", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x002, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x002", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x003, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x003", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x003, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x003", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x004, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x004", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x004, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x004", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x005, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x005", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x005, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x005", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x006, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x006", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x006, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x006", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x007, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x007", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x007, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x007", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x008, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x008", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x008, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x008", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x009, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x009", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x009, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x009", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x010, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x010", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x010, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x010", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x011, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x011", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x011, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x011", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x012, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x012", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x012, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x012", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x013, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x013", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x013, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x013", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x014, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x014", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x014, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x014", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x015, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x015", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x015, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x015", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x016, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x016", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x016, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x016", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x017, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x017", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x017, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x017", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x018, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x018", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x018, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x018", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x019, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x019", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x019, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x019", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x020, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x020", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x020, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x020", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x021, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x021", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x021, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x021", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x022, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x022", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x022, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x022", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x023, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x023", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x023, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x023", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x024, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x024", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x024, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x024", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x025, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x025", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x025, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x025", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x026, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x026", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x026, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x026", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x027, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x027", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x027, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x027", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x028, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x028", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x028, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x028", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x029, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x029", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x029, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x029", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x030, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x030", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x030, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x030", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x031, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x031", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x031, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x031", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x032, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x032", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x032, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x032", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x033, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x033", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x033, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x033", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x034, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x034", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x034, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x034", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x035, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x035", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x035, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x035", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x036, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x036", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x036, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x036", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x037, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x037", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x037, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x037", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x038, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x038", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x038, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x038", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x039, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x039", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x039, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x039", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x040, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x040", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x040, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x040", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x041, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x041", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x041, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x041", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x042, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x042", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x042, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x042", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x043, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x043", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x043, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x043", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x044, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x044", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x044, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x044", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x045, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x045", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x045, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x045", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x046, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x046", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x046, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x046", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x047, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x047", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x047, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x047", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x048, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x048", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x048, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x048", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x049, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x049", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x049, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x049", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x050, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x050", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x050, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x050", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x051, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x051", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x051, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x051", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x052, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x052", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x052, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x052", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x053, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x053", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x053, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x053", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x054, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x054", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x054, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x054", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x055, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x055", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x055, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x055", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x056, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x056", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x056, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x056", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x057, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x057", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x057, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x057", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x058, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x058", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x058, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x058", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x059, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x059", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x059, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x059", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x060, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x060", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x060, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x060", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x061, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x061", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x061, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x061", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x062, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x062", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x062, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x062", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x063, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x063", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x063, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x063", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x064, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x064", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x064, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x064", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x065, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x065", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x065, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x065", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x066, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x066", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x066, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x066", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x067, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x067", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x067, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x067", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x068, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x068", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x068, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x068", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x069, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x069", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x069, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x069", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x070, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x070", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x070, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x070", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x071, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x071", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x071, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x071", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x072, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x072", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x072, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x072", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x073, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x073", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x073, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x073", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x074, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x074", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x074, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x074", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x075, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x075", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x075, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x075", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x076, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x076", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x076, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x076", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x077, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x077", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x077, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x077", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x078, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x078", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x078, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x078", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x079, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x079", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x079, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x079", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x080, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x080", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x080, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x080", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x081, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x081", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x081, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x081", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x082, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x082", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x082, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x082", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x083, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x083", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x083, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x083", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x084, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x084", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x084, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x084", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x085, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x085", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x085, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x085", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x086, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x086", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x086, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x086", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x087, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x087", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x087, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x087", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x088, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x088", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x088, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x088", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x089, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x089", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x089, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x089", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x090, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x090", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x090, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x090", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x091, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x091", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x091, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x091", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x092, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x092", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x092, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x092", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x093, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x093", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x093, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x093", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x094, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x094", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x094, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x094", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x095, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x095", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x095, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x095", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x096, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x096", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x096, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x096", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x097, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x097", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x097, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x097", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x098, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x098", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x098, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x098", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x099, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x099", outvar);
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x099, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x099", outvar);
 
-	outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
-	copyCArrayToM( output.x100, mxGetPr(outvar), 6);
-	mxSetField(plhs[0], 0, "x100", outvar);	
+		outvar = mxCreateDoubleMatrix(6, 1, mxREAL);
+		copyCArrayToM( context.output.x100, mxGetPr(outvar), 6);
+		mxSetField(plhs[0], 0, "x100", outvar);
+	}
 
 	/* copy exitflag */
 	if( nlhs > 1 )
@@ -594,52 +706,69 @@ void mexFunction( solver_int32_default nlhs, mxArray *plhs[], solver_int32_defau
 		
 		/* iterations */
 		outvar = mxCreateDoubleMatrix(1, 1, mxREAL);
-		*mxGetPr(outvar) = (double)info.it;
+		*mxGetPr(outvar) = (double)context.info.it;
 		mxSetField(plhs[2], 0, "it", outvar);
 
 		/* iterations to optimality (branch and bound) */
 		outvar = mxCreateDoubleMatrix(1, 1, mxREAL);
-		*mxGetPr(outvar) = (double)info.it2opt;
+		*mxGetPr(outvar) = (double)context.info.it2opt;
 		mxSetField(plhs[2], 0, "it2opt", outvar);
 		
 		/* res_eq */
 		outvar = mxCreateDoubleMatrix(1, 1, mxREAL);
-		*mxGetPr(outvar) = info.res_eq;
+		*mxGetPr(outvar) = context.info.res_eq;
 		mxSetField(plhs[2], 0, "res_eq", outvar);
 
 		/* res_ineq */
 		outvar = mxCreateDoubleMatrix(1, 1, mxREAL);
-		*mxGetPr(outvar) = info.res_ineq;
+		*mxGetPr(outvar) = context.info.res_ineq;
 		mxSetField(plhs[2], 0, "res_ineq", outvar);
 
 		/* rsnorm */
 		outvar = mxCreateDoubleMatrix(1, 1, mxREAL);
-		*mxGetPr(outvar) = info.rsnorm;
+		*mxGetPr(outvar) = context.info.rsnorm;
 		mxSetField(plhs[2], 0, "rsnorm", outvar);
 
 		/* rcompnorm */
 		outvar = mxCreateDoubleMatrix(1, 1, mxREAL);
-		*mxGetPr(outvar) = info.rcompnorm;
+		*mxGetPr(outvar) = context.info.rcompnorm;
 		mxSetField(plhs[2], 0, "rcompnorm", outvar);
 		
 		/* pobj */
 		outvar = mxCreateDoubleMatrix(1, 1, mxREAL);
-		*mxGetPr(outvar) = info.pobj;
+		*mxGetPr(outvar) = context.info.pobj;
 		mxSetField(plhs[2], 0, "pobj", outvar);
 
 		/* mu */
 		outvar = mxCreateDoubleMatrix(1, 1, mxREAL);
-		*mxGetPr(outvar) = info.mu;
+		*mxGetPr(outvar) = context.info.mu;
 		mxSetField(plhs[2], 0, "mu", outvar);
 
 		/* solver time */
 		outvar = mxCreateDoubleMatrix(1, 1, mxREAL);
-		*mxGetPr(outvar) = info.solvetime;
+		*mxGetPr(outvar) = context.info.solvetime;
 		mxSetField(plhs[2], 0, "solvetime", outvar);
 
 		/* solver time */
 		outvar = mxCreateDoubleMatrix(1, 1, mxREAL);
-		*mxGetPr(outvar) = info.fevalstime;
+		*mxGetPr(outvar) = context.info.fevalstime;
 		mxSetField(plhs[2], 0, "fevalstime", outvar);
 	}
-}
\ No newline at end of file
+	/* copy log, one row per record */
+	if( nlhs > 3 )
+	{
+		plhs[3] = mxCreateDoubleMatrix(nrecords, 8, mxREAL);
+		pvalue = mxGetPr(plhs[3]);
+		for( i=0; i<nrecords; i++ )
+		{
+			pvalue[i] = (double)records[i].solve;
+			pvalue[i + nrecords] = (double)records[i].step;
+			pvalue[i + 2*nrecords] = (double)records[i].done;
+			pvalue[i + 3*nrecords] = (double)records[i].exitflag;
+			pvalue[i + 4*nrecords] = records[i].time;
+			pvalue[i + 5*nrecords] = records[i].pobj;
+			pvalue[i + 6*nrecords] = records[i].res_eq;
+			pvalue[i + 7*nrecords] = records[i].res_ineq;
+		}
+	}
+}
@@ -0,0 +1,276 @@
+/*
+FORCESNLPsolver : A fast customized optimization solver.
+
+Copyright (C) 2013-2018 EMBOTECH AG [info@embotech.com]. All rights reserved.
+
+
+This software is intended for simulation and testing purposes only.
+Use of this software for any commercial purpose is prohibited.
+
+This program is distributed in the hope that it will be useful.
+EMBOTECH makes NO WARRANTIES with respect to the use of the software
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.
+
+EMBOTECH shall not have any liability for any damage arising from the use
+of the software.
+
+This Agreement shall exclusively be governed by and interpreted in
+accordance with the laws of Switzerland, excluding its principles
+of conflict of laws. The Courts of Zurich-City shall have exclusive
+jurisdiction in case of any dispute.
+
+*/
+
+/*
+ * Octave interface, the counterpart of FORCESNLPsolver_mex.c: built into
+ * FORCESNLPsolver.oct it takes the same PARAMS struct and returns the same
+ * outputs as the MEX function, see FORCESNLPsolver.m. Build it with
+ * FORCESNLPsolver_build.py oct.
+ */
+
+#include <octave/oct.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../include/FORCESNLPsolver.h"
+
+/* Some memory for the oct-file, kept between calls */
+static FORCESNLPsolver_context context;
+static solver_int32_default context_initialized = 0;
+
+/* log of the solves of one call, it replaces the text output of the
+ * solver, which goes to the null device, opened once and closed when the
+ * oct-file is unloaded */
+static FORCESNLPsolver_log solvelog;
+static FORCESNLPsolver_log_record records[FORCESNLPsolver_LOG_SIZE];
+
+static struct null_stream
+{
+	FILE *fp;
+	null_stream() : fp(NULL) {}
+	~null_stream() { if( fp != NULL ) fclose(fp); }
+} null_stream;
+
+/* copies a double field of PARAMS with one of the given sizes to dest,
+ * false if the field is optional and not given */
+static bool double_field(const octave_scalar_map &PARAMS, const char *name, octave_idx_type m, octave_idx_type n, octave_idx_type m2, octave_idx_type n2, bool optional, double *dest)
+{
+	if( !PARAMS.isfield(name) )
+	{
+		if( optional )
+		{
+			return false;
+		}
+		error("PARAMS.%s not found", name);
+	}
+	octave_value par = PARAMS.getfield(name);
+	if( !par.is_double_type() || par.iscomplex() )
+	{
+		error("PARAMS.%s must be a double.", name);
+	}
+	if( (par.rows() != m || par.columns() != n) && (par.rows() != m2 || par.columns() != n2) )
+	{
+		if( m2 == m && n2 == n )
+		{
+			error("PARAMS.%s must be of size [%d x %d]", name, (int)m, (int)n);
+		}
+		error("PARAMS.%s must be of size [%d x %d] or [%d x %d]", name, (int)m, (int)n, (int)m2, (int)n2);
+	}
+	/* the array may be a temporary (e.g. of a range), copy while it lives */
+	const NDArray values = par.array_value();
+	memcpy(dest, values.data(), m*n*sizeof(double));
+	return true;
+}
+
+/* reads an optional scalar field of PARAMS */
+static bool scalar_field(const octave_scalar_map &PARAMS, const char *name, double *value)
+{
+	if( !PARAMS.isfield(name) )
+	{
+		return false;
+	}
+	octave_value par = PARAMS.getfield(name);
+	if( !par.isnumeric() || par.numel() != 1 )
+	{
+		error("PARAMS.%s must be a scalar.", name);
+	}
+	*value = par.double_value();
+	return true;
+}
+
+/* a column vector of n values */
+static octave_value column(const FORCESNLPsolver_float *src, octave_idx_type n)
+{
+	ColumnVector v(n);
+	memcpy(v.fortran_vec(), src, n*sizeof(double));
+	return v;
+}
+
+DEFUN_DLD (FORCESNLPsolver, args, nargout,
+	"OUTPUT = FORCESNLPsolver(PARAMS) solves the multistage problem.\n"
+	"[OUTPUT, EXITFLAG, INFO, LOG] = FORCESNLPsolver(PARAMS) returns the exitflag,\n"
+	"info struct and log as well. Type 'help FORCESNLPsolver' for details.")
+{
+	/* file pointer for printing */
+	FILE *fp = NULL;
+
+	double weights[3];
+	double value;
+	solver_int32_default i;
+	solver_int32_default exitflag;
+	FORCESNLPsolver_float timelimit;
+	solver_int32_default rti;
+	solver_int32_default stacked;
+	solver_int32_default nrecords;
+	char line[FORCESNLPsolver_LOG_LINE];
+	char name[8];
+
+	/* Check for proper number of arguments */
+	if( args.length() != 1 )
+	{
+		error("This function requires exactly 1 input: PARAMS struct.\nType 'help FORCESNLPsolver' for details.");
+	}
+	if( nargout > 4 )
+	{
+		error("This function returns at most 4 outputs.\nType 'help FORCESNLPsolver' for details.");
+	}
+
+	/* Check whether params is actually a structure */
+	if( !args(0).isstruct() || args(0).numel() != 1 )
+	{
+		error("PARAMS must be a structure.");
+	}
+	const octave_scalar_map PARAMS = args(0).scalar_map_value();
+
+	if( !context_initialized )
+	{
+		FORCESNLPsolver_context_init(&context);
+		context_initialized = 1;
+	}
+
+	/* copy parameters into the right location */
+	double_field(PARAMS, "x0", 600, 1, 6, 100, false, context.params.x0);
+	double_field(PARAMS, "xinit", 4, 1, 4, 1, false, context.params.xinit);
+	double_field(PARAMS, "xfinal", 2, 1, 2, 1, false, context.params.xfinal);
+
+	/* optional active horizon, all stages if not given */
+	FORCESNLPsolver_context_set_horizon(&context, scalar_field(PARAMS, "N", &value) ? (solver_int32_default)value : FORCESNLPsolver_N);
+
+	/* optional time limit and real-time iterations, no limits if not given */
+	timelimit = scalar_field(PARAMS, "timelimit", &value) ? value : 0;
+	rti = scalar_field(PARAMS, "rti", &value) ? (solver_int32_default)value : 0;
+	FORCESNLPsolver_context_set_limits(&context, timelimit, rti);
+
+	/* optional objective weights [a b1 b2], the generated ones if not given */
+	if( double_field(PARAMS, "weights", 1, 3, 3, 1, true, weights) )
+	{
+		FORCESNLPsolver_context_set_weights(&context, weights[0], weights[1], weights[2]);
+	}
+	else
+	{
+		FORCESNLPsolver_context_set_weights(&context, FORCESNLPsolver_WEIGHT_A, FORCESNLPsolver_WEIGHT_B1, FORCESNLPsolver_WEIGHT_B2);
+	}
+
+	/* optional output as one matrix of the stages, a struct if not given */
+	stacked = scalar_field(PARAMS, "stacked", &value) ? value != 0 : 0;
+
+	/* log the solves if they are printed or returned */
+	context.log = FORCESNLPsolver_SET_PRINTLEVEL > 0 || nargout > 3 ? &solvelog : NULL;
+	FORCESNLPsolver_log_init(&solvelog);
+
+	#if FORCESNLPsolver_SET_PRINTLEVEL > 0
+		/* discard the text output of the solver, stdout if that fails */
+		if( null_stream.fp == NULL )
+		{
+			null_stream.fp = fopen(FORCESNLPsolver_NULL_DEVICE, "w");
+		}
+		fp = null_stream.fp;
+	#endif
+
+	/* call solver */
+	exitflag = FORCESNLPsolver_context_solve(&context, fp);
+
+	nrecords = FORCESNLPsolver_log_drain(&solvelog, records, FORCESNLPsolver_LOG_SIZE);
+
+	#if FORCESNLPsolver_SET_PRINTLEVEL > 0
+		/* print the log */
+		FORCESNLPsolver_log_format(NULL, line);
+		octave_stdout << line;
+		for( i=0; i<nrecords; i++ )
+		{
+			FORCESNLPsolver_log_format(records + i, line);
+			octave_stdout << line;
+		}
+		if( solvelog.dropped > 0 )
+		{
+			octave_stdout << "(" << solvelog.dropped << " older records dropped)\n";
+		}
+	#endif
+
+	octave_value_list retval(nargout > 1 ? nargout : 1);
+
+	/* copy output to octave arrays */
+	if( stacked )
+	{
+		/* the stages of the output are contiguous, column k is stage k */
+		Matrix output(6, context.horizon);
+		memcpy(output.fortran_vec(), context.output.x001, 6*context.horizon*sizeof(double));
+		retval(0) = output;
+	}
+	else
+	{
+		const FORCESNLPsolver_float *z = context.output.x001;
+		octave_scalar_map output;
+		for( i=0; i<FORCESNLPsolver_N; i++ )
+		{
+			sprintf(name, "x%03d", (int)(i + 1));
+			output.assign(name, column(z + 6*i, 6));
+		}
+		retval(0) = output;
+	}
+
+	/* copy exitflag */
+	if( nargout > 1 )
+	{
+		retval(1) = (double)exitflag;
+	}
+
+	/* copy info struct */
+	if( nargout > 2 )
+	{
+		octave_scalar_map info;
+		info.assign("it", (double)context.info.it);
+		info.assign("it2opt", (double)context.info.it2opt);
+		info.assign("res_eq", context.info.res_eq);
+		info.assign("res_ineq", context.info.res_ineq);
+		info.assign("rsnorm", context.info.rsnorm);
+		info.assign("rcompnorm", context.info.rcompnorm);
+		info.assign("pobj", context.info.pobj);
+		info.assign("mu", context.info.mu);
+		info.assign("solvetime", context.info.solvetime);
+		info.assign("fevalstime", context.info.fevalstime);
+		retval(2) = info;
+	}
+
+	/* copy log, one row per record */
+	if( nargout > 3 )
+	{
+		Matrix log(nrecords, 8);
+		double *plog = log.fortran_vec();
+		for( i=0; i<nrecords; i++ )
+		{
+			plog[i] = (double)records[i].solve;
+			plog[i + nrecords] = (double)records[i].step;
+			plog[i + 2*nrecords] = (double)records[i].done;
+			plog[i + 3*nrecords] = (double)records[i].exitflag;
+			plog[i + 4*nrecords] = records[i].time;
+			plog[i + 5*nrecords] = records[i].pobj;
+			plog[i + 6*nrecords] = records[i].res_eq;
+			plog[i + 7*nrecords] = records[i].res_ineq;
+		}
+		retval(3) = log;
+	}
+
+	return retval;
+}
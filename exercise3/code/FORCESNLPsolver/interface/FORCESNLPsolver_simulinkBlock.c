@@ -43,6 +43,9 @@ FILE * __cdecl __iob_func(void)
 /* SYSTEM INCLUDES FOR TIMING ------------------------------------------ */
 
 
+#include <stdlib.h>
+#include <string.h>
+
 /* include FORCES functions and defs */
 #include "../include/FORCESNLPsolver.h" 
 
@@ -58,6 +61,39 @@ typedef FORCESNLPsolverinterface_float FORCESNLPsolvernmpc_float;
 extern void FORCESNLPsolver_casadi2forces(double *x, double *y, double *l, double *p, double *f, double *nabla_f, double *c, double *nabla_c, double *h, double *nabla_h, double *hess, solver_int32_default stage);
 FORCESNLPsolver_extfunc pt2function = &FORCESNLPsolver_casadi2forces;
 
+/* warm start every sample hit from the solution of the previous one 
+ * shifted by one stage, the x0 input is only used when that fails */
+#ifndef FORCESNLPsolver_SIMULINK_SHIFT
+#define FORCESNLPsolver_SIMULINK_SHIFT (1)
+#endif
+
+/* solve on a worker thread and output the last completed solution, so 
+ * that a solve longer than the sampling period does not hold up the 
+ * simulation. The first sample hit waits for its solution. This mode 
+ * always shifts and does not print the log. */
+#ifndef FORCESNLPsolver_SIMULINK_ASYNC
+#define FORCESNLPsolver_SIMULINK_ASYNC (0)
+#endif
+
+/* state of one block, allocated in mdlStart and kept in its pointer work 
+ * vector, so that sample hits neither allocate nor share memory between 
+ * blocks */
+typedef struct block_state
+{
+#if FORCESNLPsolver_SIMULINK_ASYNC
+	/* controller on its worker thread and the solution put out */
+	FORCESNLPsolver_mpc_async async;
+	FORCESNLPsolver_float z[FORCESNLPsolver_N*FORCESNLPsolver_NVAR];
+#else
+	/* controller and the log of its solves, which replaces the text 
+	 * output of the solver */
+	FORCESNLPsolver_mpc mpc;
+	FORCESNLPsolver_log solvelog;
+	FORCESNLPsolver_log_record records[FORCESNLPsolver_LOG_SIZE];
+	FILE *null_stream;
+#endif
+} block_state;
+
 
 
 
@@ -616,7 +652,7 @@ static void mdlInitializeSizes(SimStruct *S)
 	/* set internal memory of block */
     ssSetNumRWork(S, 0);
     ssSetNumIWork(S, 0);
-    ssSetNumPWork(S, 0);
+    ssSetNumPWork(S, 1);
     ssSetNumModes(S, 0);
     ssSetNumNonsampledZCs(S, 0);
 
@@ -688,680 +724,123 @@ static void mdlSetDefaultPortDataTypes(SimStruct *S)
 
 
 
+/* Function: mdlStart =========================================================
+ * Abstract:
+ *    Allocates the state of the block and starts its controller.
+ */
+#define MDL_START
+static void mdlStart(SimStruct *S)
+{
+	FORCESNLPsolver_float xfinal[2] = {0, 0};
+	block_state *state = (block_state*) calloc(1, sizeof(block_state));
+
+	ssGetPWork(S)[0] = state;
+	if( state == NULL )
+	{
+		ssSetErrorStatus(S, "FORCESNLPsolver: out of memory.");
+		return;
+	}
+
+	/* the final condition is set at every sample hit */
+#if FORCESNLPsolver_SIMULINK_ASYNC
+	if( FORCESNLPsolver_mpc_async_start(&state->async, xfinal, FORCESNLPsolver_N) != 0 )
+	{
+		ssSetErrorStatus(S, "FORCESNLPsolver: could not start the solver thread.");
+	}
+#else
+	FORCESNLPsolver_mpc_init(&state->mpc, xfinal, FORCESNLPsolver_N);
+	#if FORCESNLPsolver_SET_PRINTLEVEL > 0
+		/* discard the text output of the solver, stdout if that fails */
+		state->null_stream = fopen(FORCESNLPsolver_NULL_DEVICE, "w");
+		state->mpc.fs = state->null_stream;
+		state->mpc.ctx.log = &state->solvelog;
+	#endif
+#endif
+}
+
+
+
 /* Function: mdlOutputs =======================================================
  *
 */
 static void mdlOutputs(SimStruct *S, int_T tid)
 {
-	solver_int32_default i, j, k;
-	
-	/* file pointer for printing */
-	FILE *fp = NULL;
+	solver_int32_default i, k;
 
 	/* Simulink data */
 	const real_T *x0 = (const real_T*) ssGetInputPortSignal(S,0);
 	const real_T *xinit = (const real_T*) ssGetInputPortSignal(S,1);
 	const real_T *xfinal = (const real_T*) ssGetInputPortSignal(S,2);
 	
-    real_T *x001 = (real_T*) ssGetOutputPortSignal(S,0);
-	real_T *x002 = (real_T*) ssGetOutputPortSignal(S,1);
-	real_T *x003 = (real_T*) ssGetOutputPortSignal(S,2);
-	real_T *x004 = (real_T*) ssGetOutputPortSignal(S,3);
-	real_T *x005 = (real_T*) ssGetOutputPortSignal(S,4);
-	real_T *x006 = (real_T*) ssGetOutputPortSignal(S,5);
-	real_T *x007 = (real_T*) ssGetOutputPortSignal(S,6);
-	real_T *x008 = (real_T*) ssGetOutputPortSignal(S,7);
-	real_T *x009 = (real_T*) ssGetOutputPortSignal(S,8);
-	real_T *x010 = (real_T*) ssGetOutputPortSignal(S,9);
-	real_T *x011 = (real_T*) ssGetOutputPortSignal(S,10);
-	real_T *x012 = (real_T*) ssGetOutputPortSignal(S,11);
-	real_T *x013 = (real_T*) ssGetOutputPortSignal(S,12);
-	real_T *x014 = (real_T*) ssGetOutputPortSignal(S,13);
-	real_T *x015 = (real_T*) ssGetOutputPortSignal(S,14);
-	real_T *x016 = (real_T*) ssGetOutputPortSignal(S,15);
-	real_T *x017 = (real_T*) ssGetOutputPortSignal(S,16);
-	real_T *x018 = (real_T*) ssGetOutputPortSignal(S,17);
-	real_T *x019 = (real_T*) ssGetOutputPortSignal(S,18);
-	real_T *x020 = (real_T*) ssGetOutputPortSignal(S,19);
-	real_T *x021 = (real_T*) ssGetOutputPortSignal(S,20);
-	real_T *x022 = (real_T*) ssGetOutputPortSignal(S,21);
-	real_T *x023 = (real_T*) ssGetOutputPortSignal(S,22);
-	real_T *x024 = (real_T*) ssGetOutputPortSignal(S,23);
-	real_T *x025 = (real_T*) ssGetOutputPortSignal(S,24);
-	real_T *x026 = (real_T*) ssGetOutputPortSignal(S,25);
-	real_T *x027 = (real_T*) ssGetOutputPortSignal(S,26);
-	real_T *x028 = (real_T*) ssGetOutputPortSignal(S,27);
-	real_T *x029 = (real_T*) ssGetOutputPortSignal(S,28);
-	real_T *x030 = (real_T*) ssGetOutputPortSignal(S,29);
-	real_T *x031 = (real_T*) ssGetOutputPortSignal(S,30);
-	real_T *x032 = (real_T*) ssGetOutputPortSignal(S,31);
-	real_T *x033 = (real_T*) ssGetOutputPortSignal(S,32);
-	real_T *x034 = (real_T*) ssGetOutputPortSignal(S,33);
-	real_T *x035 = (real_T*) ssGetOutputPortSignal(S,34);
-	real_T *x036 = (real_T*) ssGetOutputPortSignal(S,35);
-	real_T *x037 = (real_T*) ssGetOutputPortSignal(S,36);
-	real_T *x038 = (real_T*) ssGetOutputPortSignal(S,37);
-	real_T *x039 = (real_T*) ssGetOutputPortSignal(S,38);
-	real_T *x040 = (real_T*) ssGetOutputPortSignal(S,39);
-	real_T *x041 = (real_T*) ssGetOutputPortSignal(S,40);
-	real_T *x042 = (real_T*) ssGetOutputPortSignal(S,41);
-	real_T *x043 = (real_T*) ssGetOutputPortSignal(S,42);
-	real_T *x044 = (real_T*) ssGetOutputPortSignal(S,43);
-	real_T *x045 = (real_T*) ssGetOutputPortSignal(S,44);
-	real_T *x046 = (real_T*) ssGetOutputPortSignal(S,45);
-	real_T *x047 = (real_T*) ssGetOutputPortSignal(S,46);
-	real_T *x048 = (real_T*) ssGetOutputPortSignal(S,47);
-	real_T *x049 = (real_T*) ssGetOutputPortSignal(S,48);
-	real_T *x050 = (real_T*) ssGetOutputPortSignal(S,49);
-	real_T *x051 = (real_T*) ssGetOutputPortSignal(S,50);
-	real_T *x052 = (real_T*) ssGetOutputPortSignal(S,51);
-	real_T *x053 = (real_T*) ssGetOutputPortSignal(S,52);
-	real_T *x054 = (real_T*) ssGetOutputPortSignal(S,53);
-	real_T *x055 = (real_T*) ssGetOutputPortSignal(S,54);
-	real_T *x056 = (real_T*) ssGetOutputPortSignal(S,55);
-	real_T *x057 = (real_T*) ssGetOutputPortSignal(S,56);
-	real_T *x058 = (real_T*) ssGetOutputPortSignal(S,57);
-	real_T *x059 = (real_T*) ssGetOutputPortSignal(S,58);
-	real_T *x060 = (real_T*) ssGetOutputPortSignal(S,59);
-	real_T *x061 = (real_T*) ssGetOutputPortSignal(S,60);
-	real_T *x062 = (real_T*) ssGetOutputPortSignal(S,61);
-	real_T *x063 = (real_T*) ssGetOutputPortSignal(S,62);
-	real_T *x064 = (real_T*) ssGetOutputPortSignal(S,63);
-	real_T *x065 = (real_T*) ssGetOutputPortSignal(S,64);
-	real_T *x066 = (real_T*) ssGetOutputPortSignal(S,65);
-	real_T *x067 = (real_T*) ssGetOutputPortSignal(S,66);
-	real_T *x068 = (real_T*) ssGetOutputPortSignal(S,67);
-	real_T *x069 = (real_T*) ssGetOutputPortSignal(S,68);
-	real_T *x070 = (real_T*) ssGetOutputPortSignal(S,69);
-	real_T *x071 = (real_T*) ssGetOutputPortSignal(S,70);
-	real_T *x072 = (real_T*) ssGetOutputPortSignal(S,71);
-	real_T *x073 = (real_T*) ssGetOutputPortSignal(S,72);
-	real_T *x074 = (real_T*) ssGetOutputPortSignal(S,73);
-	real_T *x075 = (real_T*) ssGetOutputPortSignal(S,74);
-	real_T *x076 = (real_T*) ssGetOutputPortSignal(S,75);
-	real_T *x077 = (real_T*) ssGetOutputPortSignal(S,76);
-	real_T *x078 = (real_T*) ssGetOutputPortSignal(S,77);
-	real_T *x079 = (real_T*) ssGetOutputPortSignal(S,78);
-	real_T *x080 = (real_T*) ssGetOutputPortSignal(S,79);
-	real_T *x081 = (real_T*) ssGetOutputPortSignal(S,80);
-	real_T *x082 = (real_T*) ssGetOutputPortSignal(S,81);
-	real_T *x083 = (real_T*) ssGetOutputPortSignal(S,82);
-	real_T *x084 = (real_T*) ssGetOutputPortSignal(S,83);
-	real_T *x085 = (real_T*) ssGetOutputPortSignal(S,84);
-	real_T *x086 = (real_T*) ssGetOutputPortSignal(S,85);
-	real_T *x087 = (real_T*) ssGetOutputPortSignal(S,86);
-	real_T *x088 = (real_T*) ssGetOutputPortSignal(S,87);
-	real_T *x089 = (real_T*) ssGetOutputPortSignal(S,88);
-	real_T *x090 = (real_T*) ssGetOutputPortSignal(S,89);
-	real_T *x091 = (real_T*) ssGetOutputPortSignal(S,90);
-	real_T *x092 = (real_T*) ssGetOutputPortSignal(S,91);
-	real_T *x093 = (real_T*) ssGetOutputPortSignal(S,92);
-	real_T *x094 = (real_T*) ssGetOutputPortSignal(S,93);
-	real_T *x095 = (real_T*) ssGetOutputPortSignal(S,94);
-	real_T *x096 = (real_T*) ssGetOutputPortSignal(S,95);
-	real_T *x097 = (real_T*) ssGetOutputPortSignal(S,96);
-	real_T *x098 = (real_T*) ssGetOutputPortSignal(S,97);
-	real_T *x099 = (real_T*) ssGetOutputPortSignal(S,98);
-	real_T *x100 = (real_T*) ssGetOutputPortSignal(S,99);
-	
-	
 
 	/* Solver data */
-	FORCESNLPsolver_params params;
-	FORCESNLPsolver_output output;
-	FORCESNLPsolver_info info;	
-	solver_int32_default exitflag;
-
-	/* Extra NMPC data */
-	
-
-	/* Copy inputs */
-	for( i=0; i<600; i++)
-	{ 
-		params.x0[i] = (double) x0[i]; 
-	}
+	block_state *state = (block_state*) ssGetPWork(S)[0];
+	FORCESNLPsolver_float xinit_c[4];
+	FORCESNLPsolver_float xfinal_c[2];
+	const FORCESNLPsolver_float *z;
 
+	/* Copy inputs, the 600 of x0 are only read when there is no warm start */
 	for( i=0; i<4; i++)
 	{ 
-		params.xinit[i] = (double) xinit[i]; 
+		xinit_c[i] = (double) xinit[i]; 
 	}
 
 	for( i=0; i<2; i++)
 	{ 
-		params.xfinal[i] = (double) xfinal[i]; 
-	}
-
-	
-
-	
-
-    #if FORCESNLPsolver_SET_PRINTLEVEL > 0
-		/* Prepare file for printfs */
-        fp = fopen("stdout_temp","w+");
-		if( fp == NULL ) 
-		{
-			mexErrMsgTxt("freopen of stdout did not work.");
-		}
-		rewind(fp);
-	#endif
-
-	/* Call solver */
-	exitflag = FORCESNLPsolver_solve(&params, &output, &info, fp , pt2function);
-
-	#if FORCESNLPsolver_SET_PRINTLEVEL > 0
-		/* Read contents of printfs printed to file */
-		rewind(fp);
-		while( (i = fgetc(fp)) != EOF ) 
-		{
-			ssPrintf("%c",i);
-		}
-		fclose(fp);
-	#endif
-
-	
-
-	/* Copy outputs */
-	for( i=0; i<6; i++)
-	{ 
-		x001[i] = (real_T) output.x001[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x002[i] = (real_T) output.x002[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x003[i] = (real_T) output.x003[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x004[i] = (real_T) output.x004[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x005[i] = (real_T) output.x005[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x006[i] = (real_T) output.x006[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x007[i] = (real_T) output.x007[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x008[i] = (real_T) output.x008[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x009[i] = (real_T) output.x009[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x010[i] = (real_T) output.x010[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x011[i] = (real_T) output.x011[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x012[i] = (real_T) output.x012[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x013[i] = (real_T) output.x013[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x014[i] = (real_T) output.x014[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x015[i] = (real_T) output.x015[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x016[i] = (real_T) output.x016[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x017[i] = (real_T) output.x017[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x018[i] = (real_T) output.x018[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x019[i] = (real_T) output.x019[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x020[i] = (real_T) output.x020[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x021[i] = (real_T) output.x021[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x022[i] = (real_T) output.x022[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x023[i] = (real_T) output.x023[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x024[i] = (real_T) output.x024[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x025[i] = (real_T) output.x025[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x026[i] = (real_T) output.x026[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x027[i] = (real_T) output.x027[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x028[i] = (real_T) output.x028[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x029[i] = (real_T) output.x029[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x030[i] = (real_T) output.x030[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x031[i] = (real_T) output.x031[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x032[i] = (real_T) output.x032[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x033[i] = (real_T) output.x033[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x034[i] = (real_T) output.x034[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x035[i] = (real_T) output.x035[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x036[i] = (real_T) output.x036[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x037[i] = (real_T) output.x037[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x038[i] = (real_T) output.x038[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x039[i] = (real_T) output.x039[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x040[i] = (real_T) output.x040[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x041[i] = (real_T) output.x041[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x042[i] = (real_T) output.x042[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x043[i] = (real_T) output.x043[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x044[i] = (real_T) output.x044[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x045[i] = (real_T) output.x045[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x046[i] = (real_T) output.x046[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x047[i] = (real_T) output.x047[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x048[i] = (real_T) output.x048[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x049[i] = (real_T) output.x049[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x050[i] = (real_T) output.x050[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x051[i] = (real_T) output.x051[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x052[i] = (real_T) output.x052[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x053[i] = (real_T) output.x053[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x054[i] = (real_T) output.x054[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x055[i] = (real_T) output.x055[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x056[i] = (real_T) output.x056[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x057[i] = (real_T) output.x057[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x058[i] = (real_T) output.x058[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x059[i] = (real_T) output.x059[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x060[i] = (real_T) output.x060[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x061[i] = (real_T) output.x061[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x062[i] = (real_T) output.x062[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x063[i] = (real_T) output.x063[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x064[i] = (real_T) output.x064[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x065[i] = (real_T) output.x065[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x066[i] = (real_T) output.x066[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x067[i] = (real_T) output.x067[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x068[i] = (real_T) output.x068[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x069[i] = (real_T) output.x069[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x070[i] = (real_T) output.x070[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x071[i] = (real_T) output.x071[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x072[i] = (real_T) output.x072[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x073[i] = (real_T) output.x073[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x074[i] = (real_T) output.x074[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x075[i] = (real_T) output.x075[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x076[i] = (real_T) output.x076[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x077[i] = (real_T) output.x077[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x078[i] = (real_T) output.x078[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x079[i] = (real_T) output.x079[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x080[i] = (real_T) output.x080[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x081[i] = (real_T) output.x081[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x082[i] = (real_T) output.x082[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x083[i] = (real_T) output.x083[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x084[i] = (real_T) output.x084[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x085[i] = (real_T) output.x085[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x086[i] = (real_T) output.x086[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x087[i] = (real_T) output.x087[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x088[i] = (real_T) output.x088[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x089[i] = (real_T) output.x089[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x090[i] = (real_T) output.x090[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x091[i] = (real_T) output.x091[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x092[i] = (real_T) output.x092[i]; 
+		xfinal_c[i] = (double) xfinal[i]; 
 	}
 
-	for( i=0; i<6; i++)
-	{ 
-		x093[i] = (real_T) output.x093[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x094[i] = (real_T) output.x094[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x095[i] = (real_T) output.x095[i]; 
-	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x096[i] = (real_T) output.x096[i]; 
+#if FORCESNLPsolver_SIMULINK_ASYNC
+	/* Request a solve and take the last completed one */
+	i = FORCESNLPsolver_mpc_async_step(&state->async, xinit_c, xfinal_c, (const FORCESNLPsolver_float*) x0, state->z, NULL);
+	if( i == 0 )
+	{
+		/* the worker is idle after the wait, its solution can be read */
+		i = FORCESNLPsolver_mpc_async_wait(&state->async);
+		memcpy(state->z, state->async.z, sizeof(state->z));
 	}
-
-	for( i=0; i<6; i++)
-	{ 
-		x097[i] = (real_T) output.x097[i]; 
+	if( i < 0 )
+	{
+		ssSetErrorStatus(S, "FORCESNLPsolver: the solver thread is not running.");
+		return;
 	}
+	z = state->z;
+#else
+	/* Call solver, warm started from the previous solution shifted by one 
+	 * stage or from x0 */
+	state->mpc.warm = state->mpc.warm && FORCESNLPsolver_SIMULINK_SHIFT;
+	state->mpc.guess = (const FORCESNLPsolver_float*) x0;
+	memcpy(state->mpc.ctx.params.xfinal, xfinal_c, sizeof(xfinal_c));
+	FORCESNLPsolver_log_init(&state->solvelog);
+	FORCESNLPsolver_mpc_step(&state->mpc, xinit_c, NULL);
+	z = state->mpc.ctx.output.x001;
 
-	for( i=0; i<6; i++)
-	{ 
-		x098[i] = (real_T) output.x098[i]; 
-	}
+	#if FORCESNLPsolver_SET_PRINTLEVEL > 0
+	{
+		/* print the log */
+		solver_int32_default nrecords = FORCESNLPsolver_log_drain(&state->solvelog, state->records, FORCESNLPsolver_LOG_SIZE);
+		char line[FORCESNLPsolver_LOG_LINE];
 
-	for( i=0; i<6; i++)
-	{ 
-		x099[i] = (real_T) output.x099[i]; 
+		FORCESNLPsolver_log_format(NULL, line);
+		ssPrintf("%s", line);
+		for( i=0; i<nrecords; i++ ) 
+		{
+			FORCESNLPsolver_log_format(state->records + i, line);
+			ssPrintf("%s", line);
+		}
 	}
+	#endif
+#endif
 
-	for( i=0; i<6; i++)
+	/* Copy outputs, one port per stage */
+	for( k=0; k<100; k++)
 	{ 
-		x100[i] = (real_T) output.x100[i]; 
+		real_T *stage = (real_T*) ssGetOutputPortSignal(S,k);
+		for( i=0; i<6; i++)
+		{ 
+			stage[i] = (real_T) z[6*k + i]; 
+		}
 	}
-
-	
 }
 
 
@@ -1376,6 +855,22 @@ static void mdlOutputs(SimStruct *S, int_T tid)
  */
 static void mdlTerminate(SimStruct *S)
 {
+	block_state *state = (block_state*) ssGetPWork(S)[0];
+
+	if( state == NULL )
+	{
+		return;
+	}
+#if FORCESNLPsolver_SIMULINK_ASYNC
+	FORCESNLPsolver_mpc_async_stop(&state->async);
+#else
+	if( state->null_stream != NULL )
+	{
+		fclose(state->null_stream);
+	}
+#endif
+	free(state);
+	ssGetPWork(S)[0] = NULL;
 }
 #ifdef  MATLAB_MEX_FILE    /* Is this file being compiled as a MEX-file? */
 #include "simulink.c"      /* MEX-file interface mechanism */
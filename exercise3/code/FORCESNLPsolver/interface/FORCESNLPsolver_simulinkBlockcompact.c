@@ -43,6 +43,9 @@ FILE * __cdecl __iob_func(void)
 /* SYSTEM INCLUDES FOR TIMING ------------------------------------------ */
 
 
+#include <stdlib.h>
+#include <string.h>
+
 /* include FORCES functions and defs */
 #include "../include/FORCESNLPsolver.h" 
 
@@ -58,6 +61,39 @@ typedef FORCESNLPsolverinterface_float FORCESNLPsolvernmpc_float;
 extern void FORCESNLPsolver_casadi2forces(double *x, double *y, double *l, double *p, double *f, double *nabla_f, double *c, double *nabla_c, double *h, double *nabla_h, double *hess, solver_int32_default stage);
 FORCESNLPsolver_extfunc pt2function = &FORCESNLPsolver_casadi2forces;
 
+/* warm start every sample hit from the solution of the previous one 
+ * shifted by one stage, the x0 input is only used when that fails */
+#ifndef FORCESNLPsolver_SIMULINK_SHIFT
+#define FORCESNLPsolver_SIMULINK_SHIFT (1)
+#endif
+
+/* solve on a worker thread and output the last completed solution, so 
+ * that a solve longer than the sampling period does not hold up the 
+ * simulation. The first sample hit waits for its solution. This mode 
+ * always shifts and does not print the log. */
+#ifndef FORCESNLPsolver_SIMULINK_ASYNC
+#define FORCESNLPsolver_SIMULINK_ASYNC (0)
+#endif
+
+/* state of one block, allocated in mdlStart and kept in its pointer work 
+ * vector, so that sample hits neither allocate nor share memory between 
+ * blocks */
+typedef struct block_state
+{
+#if FORCESNLPsolver_SIMULINK_ASYNC
+	/* controller on its worker thread and the solution put out */
+	FORCESNLPsolver_mpc_async async;
+	FORCESNLPsolver_float z[FORCESNLPsolver_N*FORCESNLPsolver_NVAR];
+#else
+	/* controller and the log of its solves, which replaces the text 
+	 * output of the solver */
+	FORCESNLPsolver_mpc mpc;
+	FORCESNLPsolver_log solvelog;
+	FORCESNLPsolver_log_record records[FORCESNLPsolver_LOG_SIZE];
+	FILE *null_stream;
+#endif
+} block_state;
+
 
 
 
@@ -121,7 +157,7 @@ static void mdlInitializeSizes(SimStruct *S)
 	/* set internal memory of block */
     ssSetNumRWork(S, 0);
     ssSetNumIWork(S, 0);
-    ssSetNumPWork(S, 0);
+    ssSetNumPWork(S, 1);
     ssSetNumModes(S, 0);
     ssSetNumNonsampledZCs(S, 0);
 
@@ -193,15 +229,48 @@ static void mdlSetDefaultPortDataTypes(SimStruct *S)
 
 
 
+/* Function: mdlStart =========================================================
+ * Abstract:
+ *    Allocates the state of the block and starts its controller.
+ */
+#define MDL_START
+static void mdlStart(SimStruct *S)
+{
+	FORCESNLPsolver_float xfinal[2] = {0, 0};
+	block_state *state = (block_state*) calloc(1, sizeof(block_state));
+
+	ssGetPWork(S)[0] = state;
+	if( state == NULL )
+	{
+		ssSetErrorStatus(S, "FORCESNLPsolver: out of memory.");
+		return;
+	}
+
+	/* the final condition is set at every sample hit */
+#if FORCESNLPsolver_SIMULINK_ASYNC
+	if( FORCESNLPsolver_mpc_async_start(&state->async, xfinal, FORCESNLPsolver_N) != 0 )
+	{
+		ssSetErrorStatus(S, "FORCESNLPsolver: could not start the solver thread.");
+	}
+#else
+	FORCESNLPsolver_mpc_init(&state->mpc, xfinal, FORCESNLPsolver_N);
+	#if FORCESNLPsolver_SET_PRINTLEVEL > 0
+		/* discard the text output of the solver, stdout if that fails */
+		state->null_stream = fopen(FORCESNLPsolver_NULL_DEVICE, "w");
+		state->mpc.fs = state->null_stream;
+		state->mpc.ctx.log = &state->solvelog;
+	#endif
+#endif
+}
+
+
+
 /* Function: mdlOutputs =======================================================
  *
 */
 static void mdlOutputs(SimStruct *S, int_T tid)
 {
-	solver_int32_default i, j, k;
-	
-	/* file pointer for printing */
-	FILE *fp = NULL;
+	solver_int32_default i;
 
 	/* Simulink data */
 	const real_T *x0 = (const real_T*) ssGetInputPortSignal(S,0);
@@ -209,664 +278,71 @@ static void mdlOutputs(SimStruct *S, int_T tid)
 	const real_T *xfinal = (const real_T*) ssGetInputPortSignal(S,2);
 	
     real_T *outputs = (real_T*) ssGetOutputPortSignal(S,0);
-	
-	
 
 	/* Solver data */
-	FORCESNLPsolver_params params;
-	FORCESNLPsolver_output output;
-	FORCESNLPsolver_info info;	
-	solver_int32_default exitflag;
-
-	/* Extra NMPC data */
-	
-
-	/* Copy inputs */
-	for( i=0; i<600; i++)
-	{ 
-		params.x0[i] = (double) x0[i]; 
-	}
+	block_state *state = (block_state*) ssGetPWork(S)[0];
+	FORCESNLPsolver_float xinit_c[4];
+	FORCESNLPsolver_float xfinal_c[2];
+	const FORCESNLPsolver_float *z;
 
+	/* Copy inputs, the 600 of x0 are only read when there is no warm start */
 	for( i=0; i<4; i++)
 	{ 
-		params.xinit[i] = (double) xinit[i]; 
+		xinit_c[i] = (double) xinit[i]; 
 	}
 
 	for( i=0; i<2; i++)
 	{ 
-		params.xfinal[i] = (double) xfinal[i]; 
+		xfinal_c[i] = (double) xfinal[i]; 
 	}
 
-	
-
-	
-
-    #if FORCESNLPsolver_SET_PRINTLEVEL > 0
-		/* Prepare file for printfs */
-        fp = fopen("stdout_temp","w+");
-		if( fp == NULL ) 
-		{
-			mexErrMsgTxt("freopen of stdout did not work.");
-		}
-		rewind(fp);
-	#endif
-
-	/* Call solver */
-	exitflag = FORCESNLPsolver_solve(&params, &output, &info, fp , pt2function);
+#if FORCESNLPsolver_SIMULINK_ASYNC
+	/* Request a solve and take the last completed one */
+	i = FORCESNLPsolver_mpc_async_step(&state->async, xinit_c, xfinal_c, (const FORCESNLPsolver_float*) x0, state->z, NULL);
+	if( i == 0 )
+	{
+		/* the worker is idle after the wait, its solution can be read */
+		i = FORCESNLPsolver_mpc_async_wait(&state->async);
+		memcpy(state->z, state->async.z, sizeof(state->z));
+	}
+	if( i < 0 )
+	{
+		ssSetErrorStatus(S, "FORCESNLPsolver: the solver thread is not running.");
+		return;
+	}
+	z = state->z;
+#else
+	/* Call solver, warm started from the previous solution shifted by one 
+	 * stage or from x0 */
+	state->mpc.warm = state->mpc.warm && FORCESNLPsolver_SIMULINK_SHIFT;
+	state->mpc.guess = (const FORCESNLPsolver_float*) x0;
+	memcpy(state->mpc.ctx.params.xfinal, xfinal_c, sizeof(xfinal_c));
+	FORCESNLPsolver_log_init(&state->solvelog);
+	FORCESNLPsolver_mpc_step(&state->mpc, xinit_c, NULL);
+	z = state->mpc.ctx.output.x001;
 
 	#if FORCESNLPsolver_SET_PRINTLEVEL > 0
-		/* Read contents of printfs printed to file */
-		rewind(fp);
-		while( (i = fgetc(fp)) != EOF ) 
+	{
+		/* print the log */
+		solver_int32_default nrecords = FORCESNLPsolver_log_drain(&state->solvelog, state->records, FORCESNLPsolver_LOG_SIZE);
+		char line[FORCESNLPsolver_LOG_LINE];
+
+		FORCESNLPsolver_log_format(NULL, line);
+		ssPrintf("%s", line);
+		for( i=0; i<nrecords; i++ ) 
 		{
-			ssPrintf("%c",i);
+			FORCESNLPsolver_log_format(state->records + i, line);
+			ssPrintf("%s", line);
 		}
-		fclose(fp);
+	}
 	#endif
-
-	
+#endif
 
 	/* Copy outputs */
-	for( i=0; i<6; i++)
-	{ 
-		outputs[i] = (real_T) output.x001[i]; 
-	}
-
-	k=6; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x002[i]; 
-	}
-
-	k=12; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x003[i]; 
-	}
-
-	k=18; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x004[i]; 
-	}
-
-	k=24; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x005[i]; 
-	}
-
-	k=30; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x006[i]; 
-	}
-
-	k=36; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x007[i]; 
-	}
-
-	k=42; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x008[i]; 
-	}
-
-	k=48; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x009[i]; 
-	}
-
-	k=54; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x010[i]; 
-	}
-
-	k=60; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x011[i]; 
-	}
-
-	k=66; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x012[i]; 
-	}
-
-	k=72; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x013[i]; 
-	}
-
-	k=78; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x014[i]; 
-	}
-
-	k=84; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x015[i]; 
-	}
-
-	k=90; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x016[i]; 
-	}
-
-	k=96; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x017[i]; 
-	}
-
-	k=102; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x018[i]; 
-	}
-
-	k=108; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x019[i]; 
-	}
-
-	k=114; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x020[i]; 
-	}
-
-	k=120; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x021[i]; 
-	}
-
-	k=126; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x022[i]; 
-	}
-
-	k=132; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x023[i]; 
-	}
-
-	k=138; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x024[i]; 
-	}
-
-	k=144; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x025[i]; 
-	}
-
-	k=150; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x026[i]; 
-	}
-
-	k=156; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x027[i]; 
-	}
-
-	k=162; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x028[i]; 
-	}
-
-	k=168; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x029[i]; 
-	}
-
-	k=174; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x030[i]; 
-	}
-
-	k=180; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x031[i]; 
-	}
-
-	k=186; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x032[i]; 
-	}
-
-	k=192; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x033[i]; 
-	}
-
-	k=198; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x034[i]; 
-	}
-
-	k=204; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x035[i]; 
-	}
-
-	k=210; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x036[i]; 
-	}
-
-	k=216; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x037[i]; 
-	}
-
-	k=222; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x038[i]; 
-	}
-
-	k=228; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x039[i]; 
-	}
-
-	k=234; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x040[i]; 
-	}
-
-	k=240; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x041[i]; 
-	}
-
-	k=246; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x042[i]; 
-	}
-
-	k=252; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x043[i]; 
-	}
-
-	k=258; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x044[i]; 
-	}
-
-	k=264; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x045[i]; 
-	}
-
-	k=270; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x046[i]; 
-	}
-
-	k=276; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x047[i]; 
-	}
-
-	k=282; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x048[i]; 
-	}
-
-	k=288; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x049[i]; 
-	}
-
-	k=294; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x050[i]; 
-	}
-
-	k=300; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x051[i]; 
-	}
-
-	k=306; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x052[i]; 
-	}
-
-	k=312; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x053[i]; 
-	}
-
-	k=318; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x054[i]; 
-	}
-
-	k=324; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x055[i]; 
-	}
-
-	k=330; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x056[i]; 
-	}
-
-	k=336; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x057[i]; 
-	}
-
-	k=342; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x058[i]; 
-	}
-
-	k=348; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x059[i]; 
-	}
-
-	k=354; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x060[i]; 
-	}
-
-	k=360; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x061[i]; 
-	}
-
-	k=366; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x062[i]; 
-	}
-
-	k=372; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x063[i]; 
-	}
-
-	k=378; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x064[i]; 
-	}
-
-	k=384; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x065[i]; 
-	}
-
-	k=390; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x066[i]; 
-	}
-
-	k=396; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x067[i]; 
-	}
-
-	k=402; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x068[i]; 
-	}
-
-	k=408; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x069[i]; 
-	}
-
-	k=414; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x070[i]; 
-	}
-
-	k=420; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x071[i]; 
-	}
-
-	k=426; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x072[i]; 
-	}
-
-	k=432; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x073[i]; 
-	}
-
-	k=438; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x074[i]; 
-	}
-
-	k=444; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x075[i]; 
-	}
-
-	k=450; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x076[i]; 
-	}
-
-	k=456; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x077[i]; 
-	}
-
-	k=462; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x078[i]; 
-	}
-
-	k=468; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x079[i]; 
-	}
-
-	k=474; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x080[i]; 
-	}
-
-	k=480; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x081[i]; 
-	}
-
-	k=486; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x082[i]; 
-	}
-
-	k=492; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x083[i]; 
-	}
-
-	k=498; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x084[i]; 
-	}
-
-	k=504; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x085[i]; 
-	}
-
-	k=510; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x086[i]; 
-	}
-
-	k=516; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x087[i]; 
-	}
-
-	k=522; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x088[i]; 
-	}
-
-	k=528; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x089[i]; 
-	}
-
-	k=534; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x090[i]; 
-	}
-
-	k=540; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x091[i]; 
-	}
-
-	k=546; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x092[i]; 
-	}
-
-	k=552; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x093[i]; 
-	}
-
-	k=558; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x094[i]; 
-	}
-
-	k=564; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x095[i]; 
-	}
-
-	k=570; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x096[i]; 
-	}
-
-	k=576; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x097[i]; 
-	}
-
-	k=582; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x098[i]; 
-	}
-
-	k=588; 
-	for( i=0; i<6; i++)
-	{ 
-		outputs[k++] = (real_T) output.x099[i]; 
-	}
-
-	k=594; 
-	for( i=0; i<6; i++)
+	for( i=0; i<600; i++)
 	{ 
-		outputs[k++] = (real_T) output.x100[i]; 
+		outputs[i] = (real_T) z[i]; 
 	}
-
-	
 }
 
 
@@ -881,6 +357,22 @@ static void mdlOutputs(SimStruct *S, int_T tid)
  */
 static void mdlTerminate(SimStruct *S)
 {
+	block_state *state = (block_state*) ssGetPWork(S)[0];
+
+	if( state == NULL )
+	{
+		return;
+	}
+#if FORCESNLPsolver_SIMULINK_ASYNC
+	FORCESNLPsolver_mpc_async_stop(&state->async);
+#else
+	if( state->null_stream != NULL )
+	{
+		fclose(state->null_stream);
+	}
+#endif
+	free(state);
+	ssGetPWork(S)[0] = NULL;
 }
 #ifdef  MATLAB_MEX_FILE    /* Is this file being compiled as a MEX-file? */
 #include "simulink.c"      /* MEX-file interface mechanism */
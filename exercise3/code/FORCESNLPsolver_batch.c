@@ -0,0 +1,146 @@
+/*
+ * Batch solves: many independent problems, distributed over a pool of
+ * OpenMP threads with dynamic scheduling, each thread solving into its
+ * own FORCESNLPsolver_context. Without OpenMP, or without
+ * FORCESNLPsolver_THREADSAFE_STORAGE, where the solves would only queue
+ * up behind the lock of the solver, the problems are solved one after the
+ * other on the calling thread.
+ *
+ * The problems come either as an array of params or as stacked arrays of
+ * x0, xinit and xfinal, as NumPy holds them, with the solutions stacked
+ * the same way.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+/* stacked problems and solutions, one row per problem */
+typedef struct stacked
+{
+    const FORCESNLPsolver_float *x0;
+    const FORCESNLPsolver_float *xinit;
+    const FORCESNLPsolver_float *xfinal;
+    FORCESNLPsolver_float *z;
+} stacked;
+
+/* solves n problems, given as params and output or as stacked arrays */
+static solver_int32_default batch(solver_int32_default n, const FORCESNLPsolver_params *params, FORCESNLPsolver_output *output, const stacked *arrays, solver_int32_default *exitflag, FORCESNLPsolver_info *info, solver_int32_default nthreads, FORCESNLPsolver_batch_stats *stats)
+{
+    FORCESNLPsolver_context *contexts;
+    FORCESNLPsolver_float start = FORCESNLPsolver_walltime();
+    FORCESNLPsolver_float solvetime = 0;
+    solver_int32_default horizon = FORCESNLPsolver_context_current()->horizon;
+    solver_int32_default noptimal = 0;
+    solver_int32_default i;
+
+#if defined(_OPENMP) && FORCESNLPsolver_THREADSAFE_STORAGE
+    nthreads = nthreads > 0 ? nthreads : omp_get_max_threads();
+#else
+    nthreads = 1;
+#endif
+    nthreads = nthreads < n ? nthreads : n > 0 ? n : 1;
+
+    /* one context per thread, reused for all its problems */
+    contexts = (FORCESNLPsolver_context *)malloc(nthreads*sizeof(FORCESNLPsolver_context));
+    if( contexts == NULL )
+    {
+        return FORCESNLPsolver_NOMEMORY;
+    }
+
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(nthreads) reduction(+:noptimal, solvetime)
+#endif
+    {
+#ifdef _OPENMP
+        FORCESNLPsolver_context *ctx = contexts + omp_get_thread_num();
+#else
+        FORCESNLPsolver_context *ctx = contexts;
+#endif
+        solver_int32_default flag;
+
+        FORCESNLPsolver_context_init(ctx);
+        FORCESNLPsolver_context_set_horizon(ctx, horizon);
+
+        /* solve times differ a lot between problems, hand them out one by one */
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 1)
+#endif
+        for( i=0; i<n; i++ )
+        {
+            if( params )
+            {
+                ctx->params = params[i];
+            }
+            else
+            {
+                memcpy(ctx->params.x0, arrays->x0 + i*FORCESNLPsolver_N*FORCESNLPsolver_NVAR, sizeof(ctx->params.x0));
+                memcpy(ctx->params.xinit, arrays->xinit + i*4, sizeof(ctx->params.xinit));
+                memcpy(ctx->params.xfinal, arrays->xfinal + i*2, sizeof(ctx->params.xfinal));
+            }
+            flag = FORCESNLPsolver_context_solve(ctx, NULL);
+
+            if( params )
+            {
+                output[i] = ctx->output;
+            }
+            else
+            {
+                memcpy(arrays->z + i*FORCESNLPsolver_N*FORCESNLPsolver_NVAR, ctx->output.x001, FORCESNLPsolver_N*FORCESNLPsolver_NVAR*sizeof(FORCESNLPsolver_float));
+            }
+            if( exitflag )
+            {
+                exitflag[i] = flag;
+            }
+            if( info )
+            {
+                info[i] = ctx->info;
+            }
+            noptimal += flag == FORCESNLPsolver_OPTIMAL;
+            solvetime += ctx->info.solvetime;
+        }
+    }
+
+    free(contexts);
+
+    if( stats )
+    {
+        stats->nsolves = n;
+        stats->noptimal = noptimal;
+        stats->nthreads = nthreads;
+        stats->walltime = FORCESNLPsolver_walltime() - start;
+        stats->solvetime = solvetime;
+        stats->solves_per_second = stats->walltime > 0 ? n / stats->walltime : 0;
+    }
+    return noptimal;
+}
+
+/* solves n problems */
+extern solver_int32_default FORCESNLPsolver_solve_batch(solver_int32_default n, const FORCESNLPsolver_params *params, FORCESNLPsolver_output *output, solver_int32_default *exitflag, FORCESNLPsolver_info *info, solver_int32_default nthreads, FORCESNLPsolver_batch_stats *stats)
+{
+    return batch(n, params, output, NULL, exitflag, info, nthreads, stats);
+}
+
+/* solves n stacked problems */
+extern solver_int32_default FORCESNLPsolver_solve_stacked(solver_int32_default n, const FORCESNLPsolver_float *x0, const FORCESNLPsolver_float *xinit, const FORCESNLPsolver_float *xfinal, FORCESNLPsolver_float *z, solver_int32_default *exitflag, FORCESNLPsolver_info *info, solver_int32_default nthreads, FORCESNLPsolver_batch_stats *stats)
+{
+    stacked arrays;
+
+    arrays.x0 = x0;
+    arrays.xinit = xinit;
+    arrays.xfinal = xfinal;
+    arrays.z = z;
+    return batch(n, NULL, NULL, &arrays, exitflag, info, nthreads, stats);
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -9,28 +9,330 @@
 extern "C" {
 #endif
     
+#include <string.h>
+#include <math.h>
+#ifndef NAN
+#define NAN (HUGE_VAL*0.)
+#endif
+
 #include "FORCESNLPsolver/include/FORCESNLPsolver.h"    
     
-/* prototyes for models */
-extern void FORCESNLPsolver_model_1(const FORCESNLPsolver_float **arg, FORCESNLPsolver_float **res);
-extern void FORCESNLPsolver_model_1_sparsity(solver_int32_default i, solver_int32_default *nrow, solver_int32_default *ncol, const solver_int32_default **colind, const solver_int32_default **row);
-extern void FORCESNLPsolver_model_100(const FORCESNLPsolver_float **arg, FORCESNLPsolver_float **res);
-extern void FORCESNLPsolver_model_100_sparsity(solver_int32_default i, solver_int32_default *nrow, solver_int32_default *ncol, const solver_int32_default **colind, const solver_int32_default **row);
+/* prototyes for models, FORCESNLPsolver_model_1 evaluates the stages 
+ * 0, ..., N-2 and FORCESNLPsolver_model_terminal the stage N-1 */
+extern void FORCESNLPsolver_model_1(const FORCESNLPsolver_stage_float **arg, FORCESNLPsolver_stage_float **res);
+extern void FORCESNLPsolver_model_1_valgrad(const FORCESNLPsolver_stage_float **arg, FORCESNLPsolver_stage_float **res);
+extern void FORCESNLPsolver_model_1_val(const FORCESNLPsolver_stage_float **arg, FORCESNLPsolver_stage_float **res);
+extern void FORCESNLPsolver_model_terminal(const FORCESNLPsolver_stage_float **arg, FORCESNLPsolver_stage_float **res);
+#if FORCESNLPsolver_EXACT_HESSIAN
+extern void FORCESNLPsolver_model_1_hess(const FORCESNLPsolver_float **arg, FORCESNLPsolver_float **res);
+#endif
+#ifdef FORCESNLPsolver_SINGLE_PRECISION_MODELS
+extern void FORCESNLPsolver_model_1_double_val(const FORCESNLPsolver_float **arg, FORCESNLPsolver_float **res);
+extern void FORCESNLPsolver_model_terminal_double(const FORCESNLPsolver_float **arg, FORCESNLPsolver_float **res);
+#endif
+#if FORCESNLPsolver_SIMD_WIDTH > 1
+extern void FORCESNLPsolver_model_1_simd(const FORCESNLPsolver_stage_float **arg, FORCESNLPsolver_stage_float **res);
+extern void FORCESNLPsolver_model_1_simd_valgrad(const FORCESNLPsolver_stage_float **arg, FORCESNLPsolver_stage_float **res);
+extern void FORCESNLPsolver_model_1_simd_val(const FORCESNLPsolver_stage_float **arg, FORCESNLPsolver_stage_float **res);
+#endif
+
+typedef void (*FORCESNLPsolver_model)(const FORCESNLPsolver_stage_float **arg, FORCESNLPsolver_stage_float **res);
+
+/* stage bounds, as in NLP_simpleCar.m */
+const FORCESNLPsolver_float FORCESNLPsolver_lb[FORCESNLPsolver_NVAR] = {-5., -1., -3., 0., 0., 0.};
+const FORCESNLPsolver_float FORCESNLPsolver_ub[FORCESNLPsolver_NVAR] = {5., 1., 0., 3., 2., 3.1415926535897931e+000};
+const FORCESNLPsolver_float FORCESNLPsolver_hl[FORCESNLPsolver_NH] = {1., 1.};
+const FORCESNLPsolver_float FORCESNLPsolver_hu[FORCESNLPsolver_NH] = {9., 1e30};
+
+/* picks the cheapest variant of the non-terminal stage model that 
+ * computes the requested outputs. Line search merit evaluations only 
+ * ask for values and skip the Jacobian of the dynamics entirely. */
+static FORCESNLPsolver_model select_model_1(const FORCESNLPsolver_float *nabla_f, const FORCESNLPsolver_float *nabla_c, const FORCESNLPsolver_float *nabla_h)
+{
+    if( nabla_c )
+    {
+        return FORCESNLPsolver_model_1;
+    }
+    if( nabla_f || nabla_h )
+    {
+        return FORCESNLPsolver_model_1_valgrad;
+    }
+    return FORCESNLPsolver_model_1_val;
+}
+
+#if FORCESNLPsolver_SIMD_WIDTH > 1
+/* same as select_model_1 for the SIMD kernels */
+static FORCESNLPsolver_model select_model_1_simd(const FORCESNLPsolver_float *nabla_f, const FORCESNLPsolver_float *nabla_c, const FORCESNLPsolver_float *nabla_h)
+{
+    if( nabla_c )
+    {
+        return FORCESNLPsolver_model_1_simd;
+    }
+    if( nabla_f || nabla_h )
+    {
+        return FORCESNLPsolver_model_1_simd_valgrad;
+    }
+    return FORCESNLPsolver_model_1_simd_val;
+}
+#endif
+    
+
+/* scatter maps from CasADi sparse outputs into dense column major ones. 
+ * The dense position of every nonzero is fixed by the sparsity patterns 
+ * of FORCESNLPsolver_model_1 (FORCESNLPsolver_model_terminal shares nabla_f, 
+ * h and nabla_h), so each entry is a single store. Structural zeros are 
+ * never written. Nonzero j is read from data[j*stride], a stride of 
+ * FORCESNLPsolver_SIMD_WIDTH selects one lane of the SIMD kernel output. */
+/* gradient of objective, 1 x 6, nonzeros at {0, 1, 3} */
+static void scatter_nabla_f(const FORCESNLPsolver_stage_float *data, solver_int32_default stride, FORCESNLPsolver_float *out)
+{
+    out[0] = data[0];
+    out[1] = data[stride];
+    out[3] = data[2*stride];
+}
+
+/* dynamics, 4 x 1, nonzeros at {0, 1, 2, 3} */
+static void scatter_c(const FORCESNLPsolver_stage_float *data, solver_int32_default stride, FORCESNLPsolver_float *out)
+{
+    out[0] = data[0];
+    out[1] = data[stride];
+    out[2] = data[2*stride];
+    out[3] = data[3*stride];
+}
+
+/* Jacobian of the dynamics, 4 x 6, nonzeros at {0, 1, 2, 3, 4, 5, 7, 8, 13, 16, 17, 18, 19, 20, 21, 23} */
+static void scatter_nabla_c(const FORCESNLPsolver_stage_float *data, solver_int32_default stride, FORCESNLPsolver_float *out)
+{
+    out[0] = data[0];
+    out[1] = data[stride];
+    out[2] = data[2*stride];
+    out[3] = data[3*stride];
+    out[4] = data[4*stride];
+    out[5] = data[5*stride];
+    out[7] = data[6*stride];
+    out[8] = data[7*stride];
+    out[13] = data[8*stride];
+    out[16] = data[9*stride];
+    out[17] = data[10*stride];
+    out[18] = data[11*stride];
+    out[19] = data[12*stride];
+    out[20] = data[13*stride];
+    out[21] = data[14*stride];
+    out[23] = data[15*stride];
+}
+
+/* inequalities, 2 x 1, nonzeros at {0, 1} */
+static void scatter_h(const FORCESNLPsolver_stage_float *data, solver_int32_default stride, FORCESNLPsolver_float *out)
+{
+    out[0] = data[0];
+    out[1] = data[stride];
+}
+
+/* Jacobian of inequalities, 2 x 6, nonzeros at {4, 5, 6, 7} */
+static void scatter_nabla_h(const FORCESNLPsolver_stage_float *data, solver_int32_default stride, FORCESNLPsolver_float *out)
+{
+    out[4] = data[0];
+    out[5] = data[stride];
+    out[6] = data[2*stride];
+    out[7] = data[3*stride];
+}
+
+/* changes the objective -a*y + b1*F^2 + b2*s^2 of a stage model output 
+ * from the generated weights FORCESNLPsolver_WEIGHT_* to the weights 
+ * w = [a b1 b2] of the context by adding the difference. The sparse 
+ * gradient holds F, s and y, every stride-th entry. f and nabla_f may be 
+ * NULL. */
+static void reweight(const FORCESNLPsolver_float *x, const FORCESNLPsolver_float *w, FORCESNLPsolver_stage_float *f, FORCESNLPsolver_stage_float *nabla_f, solver_int32_default stride)
+{
+    FORCESNLPsolver_float da = w[0] - FORCESNLPsolver_WEIGHT_A;
+    FORCESNLPsolver_float db1 = w[1] - FORCESNLPsolver_WEIGHT_B1;
+    FORCESNLPsolver_float db2 = w[2] - FORCESNLPsolver_WEIGHT_B2;
     
+    if( da == 0 && db1 == 0 && db2 == 0 )
+    {
+        return;
+    }
+    if( f )
+    {
+        *f += (FORCESNLPsolver_stage_float)(-da*x[3] + db1*x[0]*x[0] + db2*x[1]*x[1]);
+    }
+    if( nabla_f )
+    {
+        nabla_f[0] += (FORCESNLPsolver_stage_float)(2.*db1*x[0]);
+        nabla_f[stride] += (FORCESNLPsolver_stage_float)(2.*db2*x[1]);
+        nabla_f[2*stride] -= (FORCESNLPsolver_stage_float)da;
+    }
+}
 
-/* copies data from sparse matrix into a dense one */
-static void sparse2fullcopy(solver_int32_default nrow, solver_int32_default ncol, const solver_int32_default *colidx, const solver_int32_default *row, FORCESNLPsolver_float *data, FORCESNLPsolver_float *out)
+/* converts stage model inputs to the precision of the stage models */
+static const FORCESNLPsolver_stage_float *stage_input(const FORCESNLPsolver_float *data, solver_int32_default n, FORCESNLPsolver_stage_float *buffer)
 {
-    solver_int32_default i, j;
+#ifdef FORCESNLPsolver_SINGLE_PRECISION_MODELS
+    solver_int32_default i;
     
-    /* copy data into dense matrix */
-    for(i=0; i<ncol; i++)
+    if( data == 0 )
+    {
+        return 0;
+    }
+    for( i=0; i<n; i++ )
     {
-        for( j=colidx[i]; j < colidx[i+1]; j++ )
+        buffer[i] = (FORCESNLPsolver_stage_float)data[i];
+    }
+    return buffer;
+#else
+    (void)n;
+    (void)buffer;
+    return data;
+#endif
+}
+
+#if FORCESNLPsolver_EXACT_HESSIAN
+static void scatter_hess(const FORCESNLPsolver_float *data, solver_int32_default stride, FORCESNLPsolver_float *out)
+{
+    out[0] = data[0];
+    out[1] = data[1*stride];
+    out[4] = data[2*stride];
+    out[5] = data[3*stride];
+    out[6] = data[4*stride];
+    out[7] = data[5*stride];
+    out[10] = data[6*stride];
+    out[11] = data[7*stride];
+    out[14] = data[8*stride];
+    out[21] = data[9*stride];
+    out[24] = data[10*stride];
+    out[25] = data[11*stride];
+    out[28] = data[12*stride];
+    out[29] = data[13*stride];
+    out[30] = data[14*stride];
+    out[31] = data[15*stride];
+    out[34] = data[16*stride];
+    out[35] = data[17*stride];
+}
+
+/* exact Hessian of the Lagrangian of one stage with objective weights w, 
+ * the terminal stage has no dynamics */
+static void stage_hess(const FORCESNLPsolver_float *x, const FORCESNLPsolver_float *y, const FORCESNLPsolver_float *l, const FORCESNLPsolver_float *w, solver_int32_default stage, solver_int32_default horizon, FORCESNLPsolver_float *hess)
+{
+    const FORCESNLPsolver_float *in[4];
+    FORCESNLPsolver_float *out[1];
+    FORCESNLPsolver_float hess_sparse[18];
+    
+    in[0] = x;
+    in[1] = w;
+    in[2] = l;
+    in[3] = stage < horizon - 1 ? y : 0;
+    out[0] = hess_sparse;
+    FORCESNLPsolver_model_1_hess(in, out);
+    scatter_hess(hess_sparse, 1, hess);
+}
+#endif
+
+/* evaluates a stage behind the active horizon. Stage horizon-1 is the 
+ * terminal stage of the active horizon, the remaining padding stages only 
+ * penalize their inputs. All of them except the last one have the hold 
+ * dynamics c = [x y v theta], so the final condition imposed on stage N-1 
+ * applies to the end of the active horizon. w are the objective weights. */
+static void evaluate_tail_stage(const FORCESNLPsolver_float *x, const FORCESNLPsolver_float *p, const FORCESNLPsolver_float *w, solver_int32_default stage, solver_int32_default horizon, FORCESNLPsolver_stage_cache *sparse)
+{
+    const FORCESNLPsolver_stage_float *in[4];
+    FORCESNLPsolver_stage_float *out[4];
+    FORCESNLPsolver_stage_float x_stage[FORCESNLPsolver_NVAR];
+    FORCESNLPsolver_stage_float p_stage[FORCESNLPsolver_NPAR > 0 ? FORCESNLPsolver_NPAR : 1];
+    solver_int32_default i;
+    
+    in[0] = stage_input(x, FORCESNLPsolver_NVAR, x_stage);
+    in[1] = stage_input(p, FORCESNLPsolver_NPAR, p_stage);
+    in[2] = 0;
+    in[3] = 0;
+    out[0] = &sparse->f;
+    out[1] = sparse->nabla_f;
+    out[2] = sparse->h;
+    out[3] = sparse->nabla_h;
+    FORCESNLPsolver_model_terminal(in, out);
+    reweight(x, w, &sparse->f, sparse->nabla_f, 1);
+    
+    /* drop the progress term -a*y of the padding stages, it is linear 
+     * with gradient nabla_f[2] */
+    if( stage > horizon - 1 )
+    {
+        sparse->f -= sparse->nabla_f[2]*x[3];
+        sparse->nabla_f[2] = 0;
+    }
+    
+    /* hold dynamics */
+    for( i=0; i<4; i++ )
+    {
+        sparse->c[i] = x[2 + i];
+    }
+    for( i=0; i<16; i++ )
+    {
+        sparse->nabla_c[i] = 0;
+    }
+    sparse->nabla_c[7] = 1.;
+    sparse->nabla_c[8] = 1.;
+    sparse->nabla_c[11] = 1.;
+    sparse->nabla_c[15] = 1.;
+}
+
+#if FORCESNLPsolver_FEVAL_CACHE
+/* derivative levels of the cached outputs */
+#define CACHE_EMPTY    (0)    /* nothing                        */
+#define CACHE_VAL      (1)    /* f, h, c                        */
+#define CACHE_VALGRAD  (2)    /* f, nabla_f, h, nabla_h, c      */
+#define CACHE_FULL     (3)    /* all of the above and nabla_c   */
+
+/* checks whether the cached outputs of a stage were computed at x and p */
+static solver_int32_default cache_hit(const FORCESNLPsolver_stage_cache *entry, const FORCESNLPsolver_float *x, const FORCESNLPsolver_float *p, solver_int32_default level)
+{
+    solver_int32_default i;
+    
+    if( entry->level < level )
+    {
+        return 0;
+    }
+    for( i=0; i<FORCESNLPsolver_NVAR; i++ )
+    {
+        if( entry->z[i] != x[i] )
         {
-            out[i*nrow + row[j]] = data[j];
+            return 0;
         }
     }
+    for( i=0; i<FORCESNLPsolver_NPAR; i++ )
+    {
+        if( entry->p[i] != p[i] )
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* stores the key of a fresh evaluation */
+static void cache_store(FORCESNLPsolver_stage_cache *entry, const FORCESNLPsolver_float *x, const FORCESNLPsolver_float *p, solver_int32_default level)
+{
+    solver_int32_default i;
+    
+    for( i=0; i<FORCESNLPsolver_NVAR; i++ )
+    {
+        entry->z[i] = x[i];
+    }
+    for( i=0; i<FORCESNLPsolver_NPAR; i++ )
+    {
+        entry->p[i] = p[i];
+    }
+    entry->level = level;
+}
+#endif
+
+/* sets n entries of a dense output to NaN, NULL is skipped */
+static void fill_nan(FORCESNLPsolver_float *out, solver_int32_default n)
+{
+    solver_int32_default i;
+
+    for( i=0; out && i<n; i++ )
+    {
+        out[i] = NAN;
+    }
 }
 
 /* CasADi - FORCES interface */
@@ -49,107 +351,520 @@ extern void FORCESNLPsolver_casadi2forces(FORCESNLPsolver_float *x,        /* pr
                   )
 {
     /* CasADi input and output arrays */
-    const FORCESNLPsolver_float *in[4];
-    FORCESNLPsolver_float *out[7];
+    const FORCESNLPsolver_stage_float *in[4];
+    FORCESNLPsolver_stage_float *out[7];
+    
+    /* inputs in the precision of the stage models */
+    FORCESNLPsolver_stage_float x_stage[FORCESNLPsolver_NVAR];
+    FORCESNLPsolver_stage_float p_stage[FORCESNLPsolver_NPAR > 0 ? FORCESNLPsolver_NPAR : 1];
+    FORCESNLPsolver_stage_float l_stage[FORCESNLPsolver_NH];
+    FORCESNLPsolver_stage_float y_stage[FORCESNLPsolver_NEQ];
+    
+    /* context of the running solve */
+    FORCESNLPsolver_context *ctx = FORCESNLPsolver_context_current();
+    solver_int32_default horizon = ctx->horizon;
+    
+    /* storage for casadi sparse output */
+#if FORCESNLPsolver_FEVAL_CACHE
+    FORCESNLPsolver_stage_cache *sparse;
+    solver_int32_default level;
+#else
+    FORCESNLPsolver_stage_cache sparse_temp;
+    FORCESNLPsolver_stage_cache *sparse = &sparse_temp;
+#endif
+    
+    if( stage < 0 || stage >= FORCESNLPsolver_N )
+    {
+        return;
+    }
+    
+#if FORCESNLPsolver_FEVAL_CACHE
+    sparse = &ctx->cache[stage];
+    
+    /* stages behind the active horizon always compute everything */
+    level = stage >= horizon - 1 || nabla_c ? CACHE_FULL : nabla_f || nabla_h ? CACHE_VALGRAD : CACHE_VAL;
+    if( cache_hit(sparse, x, p, level) )
+    {
+        sparse->hits++;
+    }
+    else
+#endif
+    {
+        /* set inputs for CasADi */
+        in[0] = stage_input(x, FORCESNLPsolver_NVAR, x_stage);
+        in[1] = stage_input(p, FORCESNLPsolver_NPAR, p_stage); /* maybe should be made conditional */
+        in[2] = stage_input(l, FORCESNLPsolver_NH, l_stage); /* maybe should be made conditional */     
+        in[3] = stage_input(y, FORCESNLPsolver_NEQ, y_stage); /* maybe should be made conditional */
+        
+        /* set outputs for CasADi */
+        out[0] = &sparse->f;
+        out[1] = sparse->nabla_f;
+        out[2] = sparse->h;
+        out[3] = sparse->nabla_h;
+        out[4] = sparse->c;
+        out[5] = sparse->nabla_c;
+        
+        /* call CasADi */
+        if( stage < horizon - 1 )
+        {
+            select_model_1(nabla_f, nabla_c, nabla_h)(in, out);
+            reweight(x, ctx->weights, &sparse->f, sparse->nabla_f, 1);
+        }
+        else
+        {
+            evaluate_tail_stage(x, p, ctx->weights, stage, horizon, sparse);
+        }
+        
+#if FORCESNLPsolver_FEVAL_CACHE
+        cache_store(sparse, x, p, level);
+        sparse->misses++;
+#endif
+    }
+    
+    /* stop the solve at its deadline, iteration limit or when cancelled: 
+     * the solver returns FORCESNLPsolver_BADFUNCEVAL at the first NaN, the 
+     * context restores the last accepted iterate */
+    if( FORCESNLPsolver_context_monitor(ctx, x, sparse->f, sparse->c, sparse->h, nabla_f != NULL || nabla_c != NULL, stage) )
+    {
+        fill_nan(f, 1);
+        fill_nan(nabla_f, FORCESNLPsolver_NVAR);
+        fill_nan(c, stage < FORCESNLPsolver_N - 1 ? FORCESNLPsolver_NEQ : 0);
+        fill_nan(nabla_c, stage < FORCESNLPsolver_N - 1 ? FORCESNLPsolver_NEQ*FORCESNLPsolver_NVAR : 0);
+        fill_nan(h, FORCESNLPsolver_NH);
+        fill_nan(nabla_h, FORCESNLPsolver_NH*FORCESNLPsolver_NVAR);
+        return;
+    }
+    
+    /* copy to dense */
+    if( nabla_f )
+    {
+        scatter_nabla_f(sparse->nabla_f, 1, nabla_f);
+    }
+    if( h )
+    {
+        scatter_h(sparse->h, 1, h);
+    }
+    if( nabla_h )
+    {
+        scatter_nabla_h(sparse->nabla_h, 1, nabla_h);
+    }
+    if( stage < FORCESNLPsolver_N - 1 )
+    {
+        if( c )
+        {
+            scatter_c(sparse->c, 1, c);
+        }
+        if( nabla_c )
+        {
+            scatter_nabla_c(sparse->nabla_c, 1, nabla_c);
+        }
+    }
+    
+    /* add to objective */
+    if( f )
+    {
+        *f += sparse->f;
+    }
+    
+#if FORCESNLPsolver_EXACT_HESSIAN
+    /* depends on the multipliers, hence not cached */
+    if( hess )
+    {
+        stage_hess(x, y, l, ctx->weights, stage, horizon, hess);
+    }
+#else
+    (void)hess;
+#endif
+}
+
+/* evaluates the non-terminal stages first, ..., last-1 into the 
+ * stage-strided outputs of FORCESNLPsolver_casadi2forces_allstages, with 
+ * objective weights w */
+static void evaluate_stages(solver_int32_default first, solver_int32_default last, FORCESNLPsolver_float *x, FORCESNLPsolver_float *y, FORCESNLPsolver_float *l, FORCESNLPsolver_float *p, FORCESNLPsolver_float *f, FORCESNLPsolver_float *nabla_f, FORCESNLPsolver_float *c, FORCESNLPsolver_float *nabla_c, FORCESNLPsolver_float *h, FORCESNLPsolver_float *nabla_h, FORCESNLPsolver_float *hess, solver_int32_default horizon, const FORCESNLPsolver_float *w)
+{
+    /* CasADi input and output arrays */
+    const FORCESNLPsolver_stage_float *in[4];
+    FORCESNLPsolver_stage_float *out[7];
+    
+    /* inputs in the precision of the stage models */
+    FORCESNLPsolver_stage_float x_stage[FORCESNLPsolver_NVAR];
+    FORCESNLPsolver_stage_float p_stage[FORCESNLPsolver_NPAR > 0 ? FORCESNLPsolver_NPAR : 1];
+    FORCESNLPsolver_stage_float l_stage[FORCESNLPsolver_NH];
+    FORCESNLPsolver_stage_float y_stage[FORCESNLPsolver_NEQ];
     
     /* temporary storage for casadi sparse output */
-    FORCESNLPsolver_float this_f;
-    FORCESNLPsolver_float nabla_f_sparse[3];
-    FORCESNLPsolver_float h_sparse[2];
-    FORCESNLPsolver_float nabla_h_sparse[4];
-    FORCESNLPsolver_float c_sparse[4];
-    FORCESNLPsolver_float nabla_c_sparse[16];
-            
-    
-    /* pointers to row and column info for 
-     * column compressed format used by CasADi */
-    solver_int32_default nrow, ncol;
-    const solver_int32_default *colind, *row;
-    
-    /* set inputs for CasADi */
-    in[0] = x;
-    in[1] = p; /* maybe should be made conditional */
-    in[2] = l; /* maybe should be made conditional */     
-    in[3] = y; /* maybe should be made conditional */
+    FORCESNLPsolver_stage_float this_f;
+    FORCESNLPsolver_stage_float nabla_f_sparse[3];
+    FORCESNLPsolver_stage_float h_sparse[2];
+    FORCESNLPsolver_stage_float nabla_h_sparse[4];
+    FORCESNLPsolver_stage_float c_sparse[4];
+    FORCESNLPsolver_stage_float nabla_c_sparse[16];
+    
+    solver_int32_default stage;
+    
+    /* cheapest kernel for the requested outputs */
+    FORCESNLPsolver_model model = select_model_1(nabla_f, nabla_c, nabla_h);
+    
+#if FORCESNLPsolver_SIMD_WIDTH > 1
+    FORCESNLPsolver_model model_simd = select_model_1_simd(nabla_f, nabla_c, nabla_h);
+    
+    /* structure of arrays storage for the SIMD kernel */
+    const FORCESNLPsolver_stage_float *in_simd[2];
+    FORCESNLPsolver_stage_float *out_simd[6];
+    FORCESNLPsolver_stage_float x_simd[6*FORCESNLPsolver_SIMD_WIDTH];
+    FORCESNLPsolver_stage_float p_simd[(FORCESNLPsolver_NPAR > 0 ? FORCESNLPsolver_NPAR : 1)*FORCESNLPsolver_SIMD_WIDTH];
+    FORCESNLPsolver_stage_float f_simd[FORCESNLPsolver_SIMD_WIDTH];
+    FORCESNLPsolver_stage_float nabla_f_simd[3*FORCESNLPsolver_SIMD_WIDTH];
+    FORCESNLPsolver_stage_float h_simd[2*FORCESNLPsolver_SIMD_WIDTH];
+    FORCESNLPsolver_stage_float nabla_h_simd[4*FORCESNLPsolver_SIMD_WIDTH];
+    FORCESNLPsolver_stage_float c_simd[4*FORCESNLPsolver_SIMD_WIDTH];
+    FORCESNLPsolver_stage_float nabla_c_simd[16*FORCESNLPsolver_SIMD_WIDTH];
+    solver_int32_default i, j, k;
+#endif
     
-    /* set outputs for CasADi */
+    /* set outputs for CasADi, these do not change between stages */
     out[0] = &this_f;
     out[1] = nabla_f_sparse;
-                
-	 if ((stage >= 0 && stage < 99))
-	 {
-		 /* set inputs */
-		 out[2] = h_sparse;
-		 out[3] = nabla_h_sparse;
-		 out[4] = c_sparse;
-		 out[5] = nabla_c_sparse;
-		 
-
-		 /* call CasADi */
-		 FORCESNLPsolver_model_1(in, out);
-
-		 /* copy to dense */
-		 if( nabla_f )
-		 {
-			 FORCESNLPsolver_model_1_sparsity(3, &nrow, &ncol, &colind, &row);
-			 sparse2fullcopy(nrow, ncol, colind, row, nabla_f_sparse, nabla_f);
-		 }
-		 if( c )
-		 {
-			 FORCESNLPsolver_model_1_sparsity(6, &nrow, &ncol, &colind, &row);
-			 sparse2fullcopy(nrow, ncol, colind, row, c_sparse, c);
-		 }
-		 if( nabla_c )
-		 {
-			 FORCESNLPsolver_model_1_sparsity(7, &nrow, &ncol, &colind, &row);
-			 sparse2fullcopy(nrow, ncol, colind, row, nabla_c_sparse, nabla_c);
-		 }
-		 if( h )
-		 {
-			 FORCESNLPsolver_model_1_sparsity(4, &nrow, &ncol, &colind, &row);
-			 sparse2fullcopy(nrow, ncol, colind, row, h_sparse, h);
-		 }
-		 if( nabla_h )
-		 {
-			 FORCESNLPsolver_model_1_sparsity(5, &nrow, &ncol, &colind, &row);
-			 sparse2fullcopy(nrow, ncol, colind, row, nabla_h_sparse, nabla_h);
-		 }
-		 
-	 }
-
-	 if ((stage >= 99 && stage < 100))
-	 {
-		 /* set inputs */
-		 out[2] = h_sparse;
-		 out[3] = nabla_h_sparse;
-		 /* call CasADi */
-		 FORCESNLPsolver_model_100(in, out);
-
-		 /* copy to dense */
-		 if( nabla_f )
-		 {
-			 FORCESNLPsolver_model_100_sparsity(3, &nrow, &ncol, &colind, &row);
-			 sparse2fullcopy(nrow, ncol, colind, row, nabla_f_sparse, nabla_f);
-		 }
-		 if( h )
-		 {
-			 FORCESNLPsolver_model_100_sparsity(4, &nrow, &ncol, &colind, &row);
-			 sparse2fullcopy(nrow, ncol, colind, row, h_sparse, h);
-		 }
-		 if( nabla_h )
-		 {
-			 FORCESNLPsolver_model_100_sparsity(5, &nrow, &ncol, &colind, &row);
-			 sparse2fullcopy(nrow, ncol, colind, row, nabla_h_sparse, nabla_h);
-		 }
-		 
-	 }
-
-         
+    out[2] = h_sparse;
+    out[3] = nabla_h_sparse;
+    out[4] = c_sparse;
+    out[5] = nabla_c_sparse;
     
-    /* add to objective */
-    if( f )
+    stage = first;
+    
+#if FORCESNLPsolver_SIMD_WIDTH > 1
+    /* blocks of FORCESNLPsolver_SIMD_WIDTH stages, outputs not requested
+     * by the caller are not stored by the kernel */
+    in_simd[0] = x_simd;
+    in_simd[1] = p_simd;
+    out_simd[0] = f ? f_simd : 0;
+    out_simd[1] = nabla_f ? nabla_f_simd : 0;
+    out_simd[2] = h ? h_simd : 0;
+    out_simd[3] = nabla_h ? nabla_h_simd : 0;
+    out_simd[4] = c ? c_simd : 0;
+    out_simd[5] = nabla_c ? nabla_c_simd : 0;
+    
+    for( ; stage + FORCESNLPsolver_SIMD_WIDTH <= last; stage += FORCESNLPsolver_SIMD_WIDTH )
+    {
+        /* transpose primal vars to structure of arrays */
+        for( j=0; j<FORCESNLPsolver_SIMD_WIDTH; j++ )
+        {
+            for( i=0; i<6; i++ )
+            {
+                x_simd[i*FORCESNLPsolver_SIMD_WIDTH + j] = x[(stage + j)*FORCESNLPsolver_NVAR + i];
+            }
+            for( i=0; p && i<FORCESNLPsolver_NPAR; i++ )
+            {
+                p_simd[i*FORCESNLPsolver_SIMD_WIDTH + j] = p[(stage + j)*FORCESNLPsolver_NPAR + i];
+            }
+        }
+        
+        model_simd(in_simd, out_simd);
+        
+        /* copy to dense */
+        for( j=0; j<FORCESNLPsolver_SIMD_WIDTH; j++ )
+        {
+            k = stage + j;
+            reweight(x + k*FORCESNLPsolver_NVAR, w, f ? f_simd + j : 0, nabla_f ? nabla_f_simd + j : 0, FORCESNLPsolver_SIMD_WIDTH);
+            if( f )
+            {
+                f[k] = f_simd[j];
+            }
+            if( nabla_f )
+            {
+                scatter_nabla_f(nabla_f_simd + j, FORCESNLPsolver_SIMD_WIDTH, nabla_f + k*FORCESNLPsolver_NVAR);
+            }
+            if( c )
+            {
+                scatter_c(c_simd + j, FORCESNLPsolver_SIMD_WIDTH, c + k*FORCESNLPsolver_NEQ);
+            }
+            if( nabla_c )
+            {
+                scatter_nabla_c(nabla_c_simd + j, FORCESNLPsolver_SIMD_WIDTH, nabla_c + k*FORCESNLPsolver_NEQ*FORCESNLPsolver_NVAR);
+            }
+            if( h )
+            {
+                scatter_h(h_simd + j, FORCESNLPsolver_SIMD_WIDTH, h + k*FORCESNLPsolver_NH);
+            }
+            if( nabla_h )
+            {
+                scatter_nabla_h(nabla_h_simd + j, FORCESNLPsolver_SIMD_WIDTH, nabla_h + k*FORCESNLPsolver_NH*FORCESNLPsolver_NVAR);
+            }
+        }
+    }
+#endif
+    
+    /* remaining stages one at a time */
+    for( ; stage < last; stage++ )
+    {
+        /* set inputs for CasADi */
+        in[0] = stage_input(x + stage*FORCESNLPsolver_NVAR, FORCESNLPsolver_NVAR, x_stage);
+        in[1] = stage_input(p ? p + stage*FORCESNLPsolver_NPAR : 0, FORCESNLPsolver_NPAR, p_stage);
+        in[2] = stage_input(l ? l + stage*FORCESNLPsolver_NH : 0, FORCESNLPsolver_NH, l_stage);
+        in[3] = stage_input(y ? y + stage*FORCESNLPsolver_NEQ : 0, FORCESNLPsolver_NEQ, y_stage);
+        
+        /* call CasADi */
+        model(in, out);
+        reweight(x + stage*FORCESNLPsolver_NVAR, w, &this_f, nabla_f ? nabla_f_sparse : 0, 1);
+        
+        /* copy to dense */
+        if( f )
+        {
+            f[stage] = this_f;
+        }
+        if( nabla_f )
+        {
+            scatter_nabla_f(nabla_f_sparse, 1, nabla_f + stage*FORCESNLPsolver_NVAR);
+        }
+        if( c )
+        {
+            scatter_c(c_sparse, 1, c + stage*FORCESNLPsolver_NEQ);
+        }
+        if( nabla_c )
+        {
+            scatter_nabla_c(nabla_c_sparse, 1, nabla_c + stage*FORCESNLPsolver_NEQ*FORCESNLPsolver_NVAR);
+        }
+        if( h )
+        {
+            scatter_h(h_sparse, 1, h + stage*FORCESNLPsolver_NH);
+        }
+        if( nabla_h )
+        {
+            scatter_nabla_h(nabla_h_sparse, 1, nabla_h + stage*FORCESNLPsolver_NH*FORCESNLPsolver_NVAR);
+        }
+    }
+    
+#if FORCESNLPsolver_EXACT_HESSIAN
+    if( hess )
+    {
+        for( stage=first; stage<last; stage++ )
+        {
+            stage_hess(x + stage*FORCESNLPsolver_NVAR, y ? y + stage*FORCESNLPsolver_NEQ : 0, l ? l + stage*FORCESNLPsolver_NH : 0, w, stage, horizon, hess + stage*FORCESNLPsolver_NVAR*FORCESNLPsolver_NVAR);
+        }
+    }
+#else
+    (void)hess;
+    (void)horizon;
+#endif
+}
+
+/* CasADi - FORCES interface, evaluates all stages in one call */
+extern void FORCESNLPsolver_casadi2forces_allstages(FORCESNLPsolver_float *x,        /* primal vars of all stages                           */
+                                 FORCESNLPsolver_float *y,        /* eq. constraint multiplers of all stages             */
+                                 FORCESNLPsolver_float *l,        /* ineq. constraint multipliers of all stages          */
+                                 FORCESNLPsolver_float *p,        /* parameters of all stages                            */
+                                 FORCESNLPsolver_float *f,        /* objective function, one entry per stage             */
+                                 FORCESNLPsolver_float *nabla_f,  /* gradients of objective function                     */
+                                 FORCESNLPsolver_float *c,        /* dynamics                                            */
+                                 FORCESNLPsolver_float *nabla_c,  /* Jacobians of the dynamics (column major)            */
+                                 FORCESNLPsolver_float *h,        /* inequality constraints                              */
+                                 FORCESNLPsolver_float *nabla_h,  /* Jacobians of inequality constraints (column major)  */
+                                 FORCESNLPsolver_float *hess      /* Hessians (column major)                             */
+                  )
+{
+    /* temporary storage for casadi sparse output */
+    FORCESNLPsolver_stage_cache sparse;
+    
+    /* active horizon and objective weights of the running solve */
+    FORCESNLPsolver_context *ctx = FORCESNLPsolver_context_current();
+    solver_int32_default horizon = ctx->horizon;
+    const FORCESNLPsolver_float *w = ctx->weights;
+    
+    solver_int32_default stage;
+    
+    evaluate_stages(0, horizon - 1, x, y, l, p, f, nabla_f, c, nabla_c, h, nabla_h, hess, horizon, w);
+    
+    /* terminal stage of the active horizon and padding stages */
+    for( stage=horizon-1; stage<FORCESNLPsolver_N; stage++ )
+    {
+        evaluate_tail_stage(x + stage*FORCESNLPsolver_NVAR, p ? p + stage*FORCESNLPsolver_NPAR : 0, w, stage, horizon, &sparse);
+        
+        if( f )
+        {
+            f[stage] = sparse.f;
+        }
+        if( nabla_f )
+        {
+            scatter_nabla_f(sparse.nabla_f, 1, nabla_f + stage*FORCESNLPsolver_NVAR);
+        }
+        if( h )
+        {
+            scatter_h(sparse.h, 1, h + stage*FORCESNLPsolver_NH);
+        }
+        if( nabla_h )
+        {
+            scatter_nabla_h(sparse.nabla_h, 1, nabla_h + stage*FORCESNLPsolver_NH*FORCESNLPsolver_NVAR);
+        }
+        if( stage < FORCESNLPsolver_N - 1 )
+        {
+            if( c )
+            {
+                scatter_c(sparse.c, 1, c + stage*FORCESNLPsolver_NEQ);
+            }
+            if( nabla_c )
+            {
+                scatter_nabla_c(sparse.nabla_c, 1, nabla_c + stage*FORCESNLPsolver_NEQ*FORCESNLPsolver_NVAR);
+            }
+        }
+#if FORCESNLPsolver_EXACT_HESSIAN
+        if( hess )
+        {
+            stage_hess(x + stage*FORCESNLPsolver_NVAR, 0, l ? l + stage*FORCESNLPsolver_NH : 0, w, stage, horizon, hess + stage*FORCESNLPsolver_NVAR*FORCESNLPsolver_NVAR);
+        }
+#endif
+    }
+}
+
+/* sets the active horizon */
+extern solver_int32_default FORCESNLPsolver_casadi2forces_set_horizon(solver_int32_default N)
+{
+    return FORCESNLPsolver_context_set_horizon(FORCESNLPsolver_context_current(), N);
+}
+
+/* accuracy of the stage models compared to double precision */
+extern solver_int32_default FORCESNLPsolver_casadi2forces_precision(FORCESNLPsolver_float *x, FORCESNLPsolver_float *p, FORCESNLPsolver_float *err_eq, FORCESNLPsolver_float *err_ineq)
+{
+#ifdef FORCESNLPsolver_SINGLE_PRECISION_MODELS
+    const FORCESNLPsolver_stage_float *in[4];
+    FORCESNLPsolver_stage_float *out[6];
+    const FORCESNLPsolver_float *in_double[4];
+    FORCESNLPsolver_float *out_double[6];
+    FORCESNLPsolver_stage_float x_stage[FORCESNLPsolver_NVAR];
+    FORCESNLPsolver_stage_float p_stage[FORCESNLPsolver_NPAR > 0 ? FORCESNLPsolver_NPAR : 1];
+    FORCESNLPsolver_stage_cache sparse;
+    FORCESNLPsolver_float f_double, nabla_f_double[3], h_double[2], nabla_h_double[4], c_double[4];
+    solver_int32_default horizon = FORCESNLPsolver_context_current()->horizon;
+    solver_int32_default stage, i;
+    
+    *err_eq = 0;
+    *err_ineq = 0;
+    
+    out[0] = &sparse.f;
+    out[1] = 0;
+    out[2] = sparse.h;
+    out[3] = 0;
+    out[4] = sparse.c;
+    out[5] = 0;
+    out_double[0] = &f_double;
+    out_double[1] = nabla_f_double;
+    out_double[2] = h_double;
+    out_double[3] = nabla_h_double;
+    out_double[4] = c_double;
+    out_double[5] = 0;
+    in[2] = 0;
+    in[3] = 0;
+    in_double[2] = 0;
+    in_double[3] = 0;
+    
+    for( stage=0; stage<FORCESNLPsolver_N; stage++ )
+    {
+        in[0] = stage_input(x + stage*FORCESNLPsolver_NVAR, FORCESNLPsolver_NVAR, x_stage);
+        in[1] = stage_input(p ? p + stage*FORCESNLPsolver_NPAR : 0, FORCESNLPsolver_NPAR, p_stage);
+        in_double[0] = x + stage*FORCESNLPsolver_NVAR;
+        in_double[1] = p ? p + stage*FORCESNLPsolver_NPAR : 0;
+        
+        if( stage < horizon - 1 )
+        {
+            FORCESNLPsolver_model_1_val(in, out);
+            FORCESNLPsolver_model_1_double_val(in_double, out_double);
+        }
+        else
+        {
+            evaluate_tail_stage(x + stage*FORCESNLPsolver_NVAR, p ? p + stage*FORCESNLPsolver_NPAR : 0, FORCESNLPsolver_context_current()->weights, stage, horizon, &sparse);
+            FORCESNLPsolver_model_terminal_double(in_double, out_double);
+            for( i=0; i<4; i++ )
+            {
+                c_double[i] = x[stage*FORCESNLPsolver_NVAR + 2 + i];
+            }
+        }
+        
+        if( stage < FORCESNLPsolver_N - 1 )
+        {
+            for( i=0; i<4; i++ )
+            {
+                if( fabs(sparse.c[i] - c_double[i]) > *err_eq )
+                {
+                    *err_eq = fabs(sparse.c[i] - c_double[i]);
+                }
+            }
+        }
+        for( i=0; i<2; i++ )
+        {
+            if( fabs(sparse.h[i] - h_double[i]) > *err_ineq )
+            {
+                *err_ineq = fabs(sparse.h[i] - h_double[i]);
+            }
+        }
+    }
+    
+    return *err_eq <= FORCESNLPsolver_SET_ACC_RESEQ && *err_ineq <= FORCESNLPsolver_SET_ACC_RESINEQ;
+#else
+    (void)x;
+    (void)p;
+    *err_eq = 0;
+    *err_ineq = 0;
+    return 1;
+#endif
+}
+
+/* hit and miss counters of the stage evaluation cache */
+extern void FORCESNLPsolver_casadi2forces_cache_stats(solver_int64_default *hits, solver_int64_default *misses)
+{
+#if FORCESNLPsolver_FEVAL_CACHE
+    FORCESNLPsolver_context *ctx = FORCESNLPsolver_context_current();
+    solver_int32_default i;
+    
+    *hits = 0;
+    *misses = 0;
+    for( i=0; i<FORCESNLPsolver_N; i++ )
+    {
+        *hits += ctx->cache[i].hits;
+        *misses += ctx->cache[i].misses;
+    }
+#else
+    *hits = 0;
+    *misses = 0;
+#endif
+}
+
+/* empties the stage evaluation cache and resets its counters */
+extern void FORCESNLPsolver_casadi2forces_cache_reset(void)
+{
+#if FORCESNLPsolver_FEVAL_CACHE
+    FORCESNLPsolver_context *ctx = FORCESNLPsolver_context_current();
+    
+    memset(ctx->cache, 0, sizeof(ctx->cache));
+#endif
+}
+
+/* clears the structural zeros of the dense outputs of 
+ * FORCESNLPsolver_casadi2forces_allstages, only needed once at setup 
+ * since the scatter maps never write them */
+extern void FORCESNLPsolver_casadi2forces_allstages_clear(FORCESNLPsolver_float *nabla_f, FORCESNLPsolver_float *c, FORCESNLPsolver_float *nabla_c, FORCESNLPsolver_float *h, FORCESNLPsolver_float *nabla_h, FORCESNLPsolver_float *hess)
+{
+    if( nabla_f )
+    {
+        memset(nabla_f, 0, FORCESNLPsolver_N*FORCESNLPsolver_NVAR*sizeof(FORCESNLPsolver_float));
+    }
+    if( c )
+    {
+        memset(c, 0, FORCESNLPsolver_N*FORCESNLPsolver_NEQ*sizeof(FORCESNLPsolver_float));
+    }
+    if( nabla_c )
+    {
+        memset(nabla_c, 0, FORCESNLPsolver_N*FORCESNLPsolver_NEQ*FORCESNLPsolver_NVAR*sizeof(FORCESNLPsolver_float));
+    }
+    if( h )
+    {
+        memset(h, 0, FORCESNLPsolver_N*FORCESNLPsolver_NH*sizeof(FORCESNLPsolver_float));
+    }
+    if( nabla_h )
+    {
+        memset(nabla_h, 0, FORCESNLPsolver_N*FORCESNLPsolver_NH*FORCESNLPsolver_NVAR*sizeof(FORCESNLPsolver_float));
+    }
+    if( hess )
     {
-        *f += this_f;
+        memset(hess, 0, FORCESNLPsolver_N*FORCESNLPsolver_NVAR*FORCESNLPsolver_NVAR*sizeof(FORCESNLPsolver_float));
     }
 }
 
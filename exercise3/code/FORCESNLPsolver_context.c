@@ -0,0 +1,363 @@
+/*
+ * Solver contexts: parameters, outputs, info and stage evaluation state of
+ * one problem instance, so that several problems can be solved from
+ * different threads of one process.
+ *
+ * FORCESNLPsolver_casadi2forces is called by the solver without a user
+ * pointer, it finds the context of the running solve through a thread
+ * local pointer set by FORCESNLPsolver_context_solve. Outside of a solve
+ * it uses a default context, which keeps the single-problem interfaces
+ * working unchanged.
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <string.h>
+#include <math.h>
+#if !defined(_WIN32)
+#include <time.h>
+#endif
+
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+/* thread local storage, the one-time setup of the default context and, 
+ * unless the solver has thread safe storage, a lock around it */
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#if !FORCESNLPsolver_THREADSAFE_STORAGE
+#if defined(_WIN32)
+static SRWLOCK solve_lock = SRWLOCK_INIT;
+#define LOCK_SOLVER() AcquireSRWLockExclusive(&solve_lock)
+#define UNLOCK_SOLVER() ReleaseSRWLockExclusive(&solve_lock)
+#else
+static pthread_mutex_t solve_lock = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK_SOLVER() pthread_mutex_lock(&solve_lock)
+#define UNLOCK_SOLVER() pthread_mutex_unlock(&solve_lock)
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#define THREAD_LOCAL __thread
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+
+/* context of the single-problem interfaces, prepared once by the first 
+ * thread that uses it */
+static FORCESNLPsolver_context default_context;
+#if defined(_WIN32)
+static INIT_ONCE default_context_once = INIT_ONCE_STATIC_INIT;
+#else
+static pthread_once_t default_context_once = PTHREAD_ONCE_INIT;
+#endif
+
+/* context of the solve running on this thread, NULL outside of solves */
+static THREAD_LOCAL FORCESNLPsolver_context *current_context = 0;
+
+/* prepares a context for its first solve */
+extern void FORCESNLPsolver_context_init(FORCESNLPsolver_context *ctx)
+{
+    memset(ctx, 0, sizeof(FORCESNLPsolver_context));
+    ctx->horizon = FORCESNLPsolver_N;
+    ctx->weights[0] = FORCESNLPsolver_WEIGHT_A;
+    ctx->weights[1] = FORCESNLPsolver_WEIGHT_B1;
+    ctx->weights[2] = FORCESNLPsolver_WEIGHT_B2;
+}
+
+/* prepares the default context */
+#if defined(_WIN32)
+static BOOL CALLBACK default_context_init(PINIT_ONCE once, PVOID param, PVOID *data)
+{
+    (void)once;
+    (void)param;
+    (void)data;
+    FORCESNLPsolver_context_init(&default_context);
+    return TRUE;
+}
+#else
+static void default_context_init(void)
+{
+    FORCESNLPsolver_context_init(&default_context);
+}
+#endif
+
+/* context used by the stage evaluation on this thread */
+extern FORCESNLPsolver_context *FORCESNLPsolver_context_current(void)
+{
+    if( current_context )
+    {
+        return current_context;
+    }
+#if defined(_WIN32)
+    InitOnceExecuteOnce(&default_context_once, default_context_init, NULL, NULL);
+#else
+    pthread_once(&default_context_once, default_context_init);
+#endif
+    return &default_context;
+}
+
+/* sets the active horizon of a context */
+extern solver_int32_default FORCESNLPsolver_context_set_horizon(FORCESNLPsolver_context *ctx, solver_int32_default N)
+{
+    N = N < 1 ? 1 : N > FORCESNLPsolver_N ? FORCESNLPsolver_N : N;
+
+    /* cached outputs of stages that changed role are stale */
+    if( N != ctx->horizon )
+    {
+        ctx->horizon = N;
+        memset(ctx->cache, 0, sizeof(ctx->cache));
+    }
+    return ctx->horizon;
+}
+
+/* sets the objective weights of a context */
+extern void FORCESNLPsolver_context_set_weights(FORCESNLPsolver_context *ctx, FORCESNLPsolver_float a, FORCESNLPsolver_float b1, FORCESNLPsolver_float b2)
+{
+    /* cached objectives were computed with the old weights */
+    if( a != ctx->weights[0] || b1 != ctx->weights[1] || b2 != ctx->weights[2] )
+    {
+        ctx->weights[0] = a;
+        ctx->weights[1] = b1;
+        ctx->weights[2] = b2;
+        memset(ctx->cache, 0, sizeof(ctx->cache));
+    }
+}
+
+/* sets the time and iteration limit of a context */
+extern void FORCESNLPsolver_context_set_limits(FORCESNLPsolver_context *ctx, FORCESNLPsolver_float timelimit, solver_int32_default rti)
+{
+    ctx->timelimit = timelimit > 0 ? timelimit : 0;
+    ctx->rti = rti > 0 ? rti : 0;
+}
+
+/* appends a record of the running solve to the log of a context */
+static void log_solve(FORCESNLPsolver_context *ctx, solver_int32_default step, solver_int32_default done, solver_int32_default exitflag, FORCESNLPsolver_float pobj, FORCESNLPsolver_float res_eq, FORCESNLPsolver_float res_ineq)
+{
+    FORCESNLPsolver_log_record record;
+
+    record.solve = ctx->log->solves;
+    record.step = step;
+    record.done = done;
+    record.exitflag = exitflag;
+    record.time = FORCESNLPsolver_walltime() - ctx->monitor.start;
+    record.pobj = pobj;
+    record.res_eq = res_eq;
+    record.res_ineq = res_ineq;
+    FORCESNLPsolver_log_append(ctx->log, &record);
+}
+
+/* prepares the monitor for a solve */
+static void monitor_start(FORCESNLPsolver_context *ctx)
+{
+    FORCESNLPsolver_monitor *m = &ctx->monitor;
+
+    m->start = FORCESNLPsolver_walltime();
+    m->deadline = ctx->timelimit > 0 ? m->start + ctx->timelimit : 0;
+    m->maxit = ctx->rti;
+    m->it = -1;
+    m->next = -1;
+    m->stopped = 0;
+    m->nbest = 0;
+}
+
+/* records a stage evaluation */
+extern solver_int32_default FORCESNLPsolver_context_monitor(FORCESNLPsolver_context *ctx, const FORCESNLPsolver_float *x, FORCESNLPsolver_stage_float f, const FORCESNLPsolver_stage_float *c, const FORCESNLPsolver_stage_float *h, solver_int32_default derivatives, solver_int32_default stage)
+{
+    FORCESNLPsolver_monitor *m = &ctx->monitor;
+    FORCESNLPsolver_float res_eq = 0, res_ineq = 0, r;
+    solver_int32_default i;
+
+    if( m->stopped )
+    {
+        return 1;
+    }
+    if( m->deadline <= 0 && m->maxit <= 0 && ctx->cancel == NULL && ctx->log == NULL )
+    {
+        return 0;
+    }
+
+    /* the solver starts a new evaluation with stage 0 */
+    if( stage == 0 )
+    {
+        if( m->maxit > 0 && m->it >= m->maxit )
+        {
+            m->stopped = FORCESNLPsolver_RTI;
+        }
+        else if( m->deadline > 0 && FORCESNLPsolver_walltime() >= m->deadline )
+        {
+            m->stopped = FORCESNLPsolver_DEADLINE;
+        }
+        else if( ctx->cancel && m->it >= 0 && ctx->cancel(ctx->cancel_data, m) )
+        {
+            m->stopped = FORCESNLPsolver_CANCELLED;
+        }
+        if( m->stopped )
+        {
+            return 1;
+        }
+        m->next = 0;
+        m->derivatives = 1;
+        m->pobj = 0;
+        m->res_eq = 0;
+        m->res_ineq = 0;
+    }
+    if( stage != m->next )
+    {
+        m->next = -1;
+        return 0;
+    }
+
+    memcpy(m->x + stage*FORCESNLPsolver_NVAR, x, FORCESNLPsolver_NVAR*sizeof(FORCESNLPsolver_float));
+    m->derivatives = m->derivatives && derivatives;
+
+    /* dynamics of the previous stage, initial and final condition */
+    for( i=0; i<4; i++ )
+    {
+        r = fabs((stage > 0 ? m->c[i] : ctx->params.xinit[i]) - x[2 + i]);
+        res_eq = r > res_eq ? r : res_eq;
+    }
+    if( stage == FORCESNLPsolver_N - 1 )
+    {
+        for( i=0; i<2; i++ )
+        {
+            r = fabs(ctx->params.xfinal[i] - x[4 + i]);
+            res_eq = r > res_eq ? r : res_eq;
+        }
+    }
+    for( i=0; i<FORCESNLPsolver_NEQ; i++ )
+    {
+        m->c[i] = c[i];
+    }
+
+    /* bounds and inequalities */
+    for( i=0; i<FORCESNLPsolver_NVAR; i++ )
+    {
+        r = x[i] < FORCESNLPsolver_lb[i] ? FORCESNLPsolver_lb[i] - x[i] : x[i] - FORCESNLPsolver_ub[i];
+        res_ineq = r > res_ineq ? r : res_ineq;
+    }
+    for( i=0; i<FORCESNLPsolver_NH; i++ )
+    {
+        r = h[i] < FORCESNLPsolver_hl[i] ? FORCESNLPsolver_hl[i] - h[i] : h[i] - FORCESNLPsolver_hu[i];
+        res_ineq = r > res_ineq ? r : res_ineq;
+    }
+
+    m->pobj += f;
+    m->res_eq = res_eq > m->res_eq ? res_eq : m->res_eq;
+    m->res_ineq = res_ineq > m->res_ineq ? res_ineq : m->res_ineq;
+    m->next++;
+
+    /* a complete evaluation with derivatives at a new point is an accepted 
+     * iterate, keep it if it is the most feasible so far */
+    if( m->next == FORCESNLPsolver_N && m->derivatives && (m->it < 0 || memcmp(m->iterate, m->x, sizeof(m->iterate))) )
+    {
+        m->it++;
+        memcpy(m->iterate, m->x, sizeof(m->iterate));
+        m->iterate_pobj = m->pobj;
+        m->iterate_res_eq = m->res_eq;
+        m->iterate_res_ineq = m->res_ineq;
+        if( ctx->log )
+        {
+            log_solve(ctx, m->it, 0, 0, m->pobj, m->res_eq, m->res_ineq);
+        }
+        r = m->res_eq > m->res_ineq ? m->res_eq : m->res_ineq;
+        if( m->nbest == 0 || r <= (m->best_res_eq > m->best_res_ineq ? m->best_res_eq : m->best_res_ineq) )
+        {
+            memcpy(m->best, m->x, sizeof(m->best));
+            m->best_res_eq = m->res_eq;
+            m->best_res_ineq = m->res_ineq;
+            m->nbest++;
+        }
+    }
+    return 0;
+}
+
+/* solves the problem stored in a context */
+extern solver_int32_default FORCESNLPsolver_context_solve(FORCESNLPsolver_context *ctx, FILE *fs)
+{
+    FORCESNLPsolver_context *previous = current_context;
+    solver_int32_default exitflag;
+
+    current_context = ctx;
+    if( ctx->log )
+    {
+        ctx->log->solves++;
+    }
+
+#if !FORCESNLPsolver_THREADSAFE_STORAGE
+    /* the solver keeps its workspace in static memory */
+    LOCK_SOLVER();
+#endif
+    /* time limits and the log start once the solver is ours */
+    monitor_start(ctx);
+    exitflag = FORCESNLPsolver_solve(&ctx->params, &ctx->output, &ctx->info, fs, &FORCESNLPsolver_casadi2forces);
+#if !FORCESNLPsolver_THREADSAFE_STORAGE
+    UNLOCK_SOLVER();
+#endif
+
+    current_context = previous;
+
+    /* the solver saw NaN and returned FORCESNLPsolver_BADFUNCEVAL, replace 
+     * its output by the last accepted iterate */
+    if( ctx->monitor.stopped == FORCESNLPsolver_RTI || ctx->monitor.stopped == FORCESNLPsolver_CANCELLED )
+    {
+        memcpy(&ctx->output, ctx->monitor.iterate, sizeof(ctx->monitor.iterate));
+        ctx->info.it = ctx->monitor.it;
+        ctx->info.pobj = ctx->monitor.iterate_pobj;
+        ctx->info.res_eq = ctx->monitor.iterate_res_eq;
+        ctx->info.res_ineq = ctx->monitor.iterate_res_ineq;
+        exitflag = ctx->monitor.stopped;
+    }
+    else if( ctx->monitor.stopped == FORCESNLPsolver_DEADLINE )
+    {
+        if( ctx->monitor.nbest > 0 )
+        {
+            memcpy(&ctx->output, ctx->monitor.best, sizeof(ctx->monitor.best));
+            ctx->info.res_eq = ctx->monitor.best_res_eq;
+            ctx->info.res_ineq = ctx->monitor.best_res_ineq;
+        }
+        else
+        {
+            memcpy(&ctx->output, ctx->params.x0, sizeof(ctx->params.x0));
+        }
+        ctx->info.it = ctx->monitor.it > 0 ? ctx->monitor.it : 0;
+        exitflag = FORCESNLPsolver_DEADLINE;
+    }
+
+    if( ctx->log )
+    {
+        log_solve(ctx, ctx->info.it, 1, exitflag, ctx->info.pobj, ctx->info.res_eq, ctx->info.res_ineq);
+    }
+    return exitflag;
+}
+
+/* monotonic wall clock time in seconds */
+extern FORCESNLPsolver_float FORCESNLPsolver_walltime(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter, frequency;
+
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (FORCESNLPsolver_float)counter.QuadPart / (FORCESNLPsolver_float)frequency.QuadPart;
+#else
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (FORCESNLPsolver_float)t.tv_sec + 1e-9*(FORCESNLPsolver_float)t.tv_nsec;
+#endif
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,82 @@
+/*
+ * Solve log: a ring buffer of records of the iterates and results of
+ * solves, filled by the iterate monitor of a context. It takes the place
+ * of the text output of the solver, which would have to go through a
+ * file, so that logging needs neither the file system nor formatting
+ * during a solve.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+/* empties a log */
+extern void FORCESNLPsolver_log_init(FORCESNLPsolver_log *log)
+{
+    log->first = 0;
+    log->count = 0;
+    log->dropped = 0;
+    log->solves = 0;
+}
+
+/* appends a record */
+extern void FORCESNLPsolver_log_append(FORCESNLPsolver_log *log, const FORCESNLPsolver_log_record *record)
+{
+    solver_int32_default i = (log->first + log->count) % FORCESNLPsolver_LOG_SIZE;
+
+    log->record[i] = *record;
+    if( log->count < FORCESNLPsolver_LOG_SIZE )
+    {
+        log->count++;
+    }
+    else
+    {
+        log->first = (log->first + 1) % FORCESNLPsolver_LOG_SIZE;
+        log->dropped++;
+    }
+}
+
+/* moves the oldest records out of a log */
+extern solver_int32_default FORCESNLPsolver_log_drain(FORCESNLPsolver_log *log, FORCESNLPsolver_log_record *records, solver_int32_default max)
+{
+    solver_int32_default n = max < log->count ? max : log->count;
+    solver_int32_default head = FORCESNLPsolver_LOG_SIZE - log->first;
+
+    n = n > 0 ? n : 0;
+
+    /* at most two pieces, up to the end of the buffer and from its start */
+    head = n < head ? n : head;
+    memcpy(records, log->record + log->first, head*sizeof(FORCESNLPsolver_log_record));
+    memcpy(records + head, log->record, (n - head)*sizeof(FORCESNLPsolver_log_record));
+
+    log->first = (log->first + n) % FORCESNLPsolver_LOG_SIZE;
+    log->count -= n;
+    return n;
+}
+
+/* writes a record as a line of text */
+extern void FORCESNLPsolver_log_format(const FORCESNLPsolver_log_record *record, char *line)
+{
+    /* the widths keep the line below FORCESNLPsolver_LOG_LINE */
+    if( record == NULL )
+    {
+        sprintf(line, "%5s %5s %12s %10s %10s %10s %5s\n", "solve", "step", "pobj", "res_eq", "res_ineq", "time", "exit");
+    }
+    else if( record->done )
+    {
+        sprintf(line, "%5d %5d %12.4e %10.3e %10.3e %10.3e %5d\n", (int)(record->solve % 100000), (int)(record->step % 100000), record->pobj, record->res_eq, record->res_ineq, record->time, (int)record->exitflag);
+    }
+    else
+    {
+        sprintf(line, "%5d %5d %12.4e %10.3e %10.3e %10.3e\n", (int)(record->solve % 100000), (int)(record->step % 100000), record->pobj, record->res_eq, record->res_ineq, record->time);
+    }
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -16,10 +16,10 @@ extern "C" {
 #include "FORCESNLPsolver/include/FORCESNLPsolver.h"
 
 #define PRINTF printf
-FORCESNLPsolver_float CASADI_PREFIX(sq)(FORCESNLPsolver_float x) { return x*x;}
+FORCESNLPsolver_stage_float CASADI_PREFIX(sq)(FORCESNLPsolver_stage_float x) { return x*x;}
 #define sq(x) CASADI_PREFIX(sq)(x)
 
-FORCESNLPsolver_float CASADI_PREFIX(sign)(FORCESNLPsolver_float x) { return x<0 ? -1 : x>0 ? 1 : x;}
+FORCESNLPsolver_stage_float CASADI_PREFIX(sign)(FORCESNLPsolver_stage_float x) { return x<0 ? -1 : x>0 ? 1 : x;}
 #define sign(x) CASADI_PREFIX(sign)(x)
 
 static const solver_int32_default CASADI_PREFIX(s0)[] = {6, 1, 0, 6, 0, 1, 2, 3, 4, 5};
@@ -39,9 +39,9 @@ static const solver_int32_default CASADI_PREFIX(s6)[] = {4, 1, 0, 4, 0, 1, 2, 3}
 static const solver_int32_default CASADI_PREFIX(s7)[] = {4, 6, 0, 4, 7, 8, 9, 13, 16, 0, 1, 2, 3, 0, 1, 3, 0, 1, 0, 1, 2, 3, 0, 1, 3};
 #define s7 CASADI_PREFIX(s7)
 /* evaluate_stages */
-solver_int32_default FORCESNLPsolver_model_1(const FORCESNLPsolver_float **arg, FORCESNLPsolver_float **res) 
+solver_int32_default FORCESNLPsolver_model_1(const FORCESNLPsolver_stage_float **arg, FORCESNLPsolver_stage_float **res) 
 {
-    FORCESNLPsolver_float a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32;
+    FORCESNLPsolver_stage_float a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32;
     
     a0=-100.;
     a1=arg[0] ? arg[0][3] : 0;
@@ -336,6 +336,247 @@ solver_int32_default FORCESNLPsolver_model_1(const FORCESNLPsolver_float **arg,
     return 0;
 }
 
+/* evaluate_stages, values only: f, h and c */
+solver_int32_default FORCESNLPsolver_model_1_val(const FORCESNLPsolver_stage_float **arg, FORCESNLPsolver_stage_float **res) 
+{
+    FORCESNLPsolver_stage_float a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32;
+    
+    a0=-100.;
+    a1=arg[0] ? arg[0][3] : 0;
+    a2=(a0*a1);
+    a3=arg[0] ? arg[0][0] : 0;
+    a4=sq(a3);
+    a5=1.0000000000000001e-001;
+    a4=(a5*a4);
+    a2=(a2+a4);
+    a4=arg[0] ? arg[0][1] : 0;
+    a6=sq(a4);
+    a7=1.0000000000000000e-002;
+    a6=(a7*a6);
+    a2=(a2+a6);
+    if (res[0]!=0) res[0][0]=a2;
+    a0=arg[0] ? arg[0][2] : 0;
+    a7=sq(a0);
+    a2=sq(a1);
+    a7=(a7+a2);
+    if (res[2]!=0) res[2][0]=a7;
+    a7=2.;
+    a2=(a0+a7);
+    a6=sq(a2);
+    a8=2.5000000000000000e+000;
+    a8=(a1-a8);
+    a9=sq(a8);
+    a6=(a6+a9);
+    if (res[2]!=0) res[2][1]=a6;
+    a8=arg[0] ? arg[0][5] : 0;
+    a2=cos(a8);
+    a6=arg[0] ? arg[0][4] : 0;
+    a9=(a6*a2);
+    a10=9.0000000000000002e-001;
+    a11=(a3/a10);
+    a12=5.0000000000000003e-002;
+    a13=(a12*a11);
+    a13=(a6+a13);
+    a14=(a4*a6);
+    a15=1.2000000000000000e-001;
+    a14=(a14/a15);
+    a16=(a12*a14);
+    a16=(a8+a16);
+    a17=cos(a16);
+    a18=(a13*a17);
+    a18=(a7*a18);
+    a9=(a9+a18);
+    a18=(a3/a10);
+    a19=(a12*a18);
+    a19=(a6+a19);
+    a20=(a4*a13);
+    a20=(a20/a15);
+    a21=(a12*a20);
+    a21=(a8+a21);
+    a22=cos(a21);
+    a23=(a19*a22);
+    a23=(a7*a23);
+    a9=(a9+a23);
+    a23=(a3/a10);
+    a24=(a5*a23);
+    a24=(a6+a24);
+    a25=(a4*a19);
+    a25=(a25/a15);
+    a26=(a5*a25);
+    a26=(a8+a26);
+    a27=cos(a26);
+    a28=(a24*a27);
+    a9=(a9+a28);
+    a28=1.6666666666666666e-002;
+    a9=(a28*a9);
+    a0=(a0+a9);
+    if (res[4]!=0) res[4][0]=a0;
+    a0=sin(a8);
+    a9=(a6*a0);
+    a29=sin(a16);
+    a30=(a13*a29);
+    a30=(a7*a30);
+    a9=(a9+a30);
+    a30=sin(a21);
+    a31=(a19*a30);
+    a31=(a7*a31);
+    a9=(a9+a31);
+    a31=sin(a26);
+    a32=(a24*a31);
+    a9=(a9+a32);
+    a9=(a28*a9);
+    a1=(a1+a9);
+    if (res[4]!=0) res[4][1]=a1;
+    a18=(a7*a18);
+    a11=(a11+a18);
+    a23=(a7*a23);
+    a11=(a11+a23);
+    a3=(a3/a10);
+    a11=(a11+a3);
+    a11=(a28*a11);
+    a11=(a6+a11);
+    if (res[4]!=0) res[4][2]=a11;
+    a20=(a7*a20);
+    a14=(a14+a20);
+    a25=(a7*a25);
+    a14=(a14+a25);
+    a25=(a4*a24);
+    a25=(a25/a15);
+    a14=(a14+a25);
+    a14=(a28*a14);
+    a14=(a8+a14);
+    if (res[4]!=0) res[4][3]=a14;
+    return 0;
+}
+
+/* evaluate_stages, values and gradients of f and h, no Jacobian of the dynamics */
+solver_int32_default FORCESNLPsolver_model_1_valgrad(const FORCESNLPsolver_stage_float **arg, FORCESNLPsolver_stage_float **res) 
+{
+    FORCESNLPsolver_stage_float a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32;
+    
+    a0=-100.;
+    a1=arg[0] ? arg[0][3] : 0;
+    a2=(a0*a1);
+    a3=arg[0] ? arg[0][0] : 0;
+    a4=sq(a3);
+    a5=1.0000000000000001e-001;
+    a4=(a5*a4);
+    a2=(a2+a4);
+    a4=arg[0] ? arg[0][1] : 0;
+    a6=sq(a4);
+    a7=1.0000000000000000e-002;
+    a6=(a7*a6);
+    a2=(a2+a6);
+    if (res[0]!=0) res[0][0]=a2;
+    a2=(a3+a3);
+    a2=(a5*a2);
+    if (res[1]!=0) res[1][0]=a2;
+    a2=(a4+a4);
+    a7=(a7*a2);
+    if (res[1]!=0) res[1][1]=a7;
+    if (res[1]!=0) res[1][2]=a0;
+    a0=arg[0] ? arg[0][2] : 0;
+    a7=sq(a0);
+    a2=sq(a1);
+    a7=(a7+a2);
+    if (res[2]!=0) res[2][0]=a7;
+    a7=2.;
+    a2=(a0+a7);
+    a6=sq(a2);
+    a8=2.5000000000000000e+000;
+    a8=(a1-a8);
+    a9=sq(a8);
+    a6=(a6+a9);
+    if (res[2]!=0) res[2][1]=a6;
+    a6=(a0+a0);
+    if (res[3]!=0) res[3][0]=a6;
+    a2=(a2+a2);
+    if (res[3]!=0) res[3][1]=a2;
+    a2=(a1+a1);
+    if (res[3]!=0) res[3][2]=a2;
+    a8=(a8+a8);
+    if (res[3]!=0) res[3][3]=a8;
+    a8=arg[0] ? arg[0][5] : 0;
+    a2=cos(a8);
+    a6=arg[0] ? arg[0][4] : 0;
+    a9=(a6*a2);
+    a10=9.0000000000000002e-001;
+    a11=(a3/a10);
+    a12=5.0000000000000003e-002;
+    a13=(a12*a11);
+    a13=(a6+a13);
+    a14=(a4*a6);
+    a15=1.2000000000000000e-001;
+    a14=(a14/a15);
+    a16=(a12*a14);
+    a16=(a8+a16);
+    a17=cos(a16);
+    a18=(a13*a17);
+    a18=(a7*a18);
+    a9=(a9+a18);
+    a18=(a3/a10);
+    a19=(a12*a18);
+    a19=(a6+a19);
+    a20=(a4*a13);
+    a20=(a20/a15);
+    a21=(a12*a20);
+    a21=(a8+a21);
+    a22=cos(a21);
+    a23=(a19*a22);
+    a23=(a7*a23);
+    a9=(a9+a23);
+    a23=(a3/a10);
+    a24=(a5*a23);
+    a24=(a6+a24);
+    a25=(a4*a19);
+    a25=(a25/a15);
+    a26=(a5*a25);
+    a26=(a8+a26);
+    a27=cos(a26);
+    a28=(a24*a27);
+    a9=(a9+a28);
+    a28=1.6666666666666666e-002;
+    a9=(a28*a9);
+    a0=(a0+a9);
+    if (res[4]!=0) res[4][0]=a0;
+    a0=sin(a8);
+    a9=(a6*a0);
+    a29=sin(a16);
+    a30=(a13*a29);
+    a30=(a7*a30);
+    a9=(a9+a30);
+    a30=sin(a21);
+    a31=(a19*a30);
+    a31=(a7*a31);
+    a9=(a9+a31);
+    a31=sin(a26);
+    a32=(a24*a31);
+    a9=(a9+a32);
+    a9=(a28*a9);
+    a1=(a1+a9);
+    if (res[4]!=0) res[4][1]=a1;
+    a18=(a7*a18);
+    a11=(a11+a18);
+    a23=(a7*a23);
+    a11=(a11+a23);
+    a3=(a3/a10);
+    a11=(a11+a3);
+    a11=(a28*a11);
+    a11=(a6+a11);
+    if (res[4]!=0) res[4][2]=a11;
+    a20=(a7*a20);
+    a14=(a14+a20);
+    a25=(a7*a25);
+    a14=(a14+a25);
+    a25=(a4*a24);
+    a25=(a25/a15);
+    a14=(a14+a25);
+    a14=(a28*a14);
+    a14=(a8+a14);
+    if (res[4]!=0) res[4][3]=a14;
+    return 0;
+}
+
 solver_int32_default FORCESNLPsolver_model_1_init(solver_int32_default *f_type, solver_int32_default *n_in, solver_int32_default *n_out, solver_int32_default *sz_arg, solver_int32_default *sz_res) 
 {
     *f_type = 1;
@@ -0,0 +1,19 @@
+/* 
+ * Double precision copy of FORCESNLPsolver_model_1 for builds with single 
+ * precision stage models (FORCESNLPsolver_SINGLE_PRECISION_MODELS), used 
+ * by FORCESNLPsolver_casadi2forces_precision as the reference. Empty 
+ * otherwise.
+ */
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+#ifdef FORCESNLPsolver_SINGLE_PRECISION_MODELS
+#define CODEGEN_PREFIX FORCESNLPsolver_model_1_double_
+#define FORCESNLPsolver_stage_float FORCESNLPsolver_float
+#define FORCESNLPsolver_model_1 FORCESNLPsolver_model_1_double
+#define FORCESNLPsolver_model_1_val FORCESNLPsolver_model_1_double_val
+#define FORCESNLPsolver_model_1_valgrad FORCESNLPsolver_model_1_double_valgrad
+#define FORCESNLPsolver_model_1_init FORCESNLPsolver_model_1_double_init
+#define FORCESNLPsolver_model_1_sparsity FORCESNLPsolver_model_1_double_sparsity
+#define FORCESNLPsolver_model_1_work FORCESNLPsolver_model_1_double_work
+#include "FORCESNLPsolver_model_1.c"
+#endif
@@ -0,0 +1,190 @@
+/*
+ * Exact Hessian of the stage Lagrangian
+ *
+ *     L(z) = f(z) + y'*c(z) + l'*h(z)
+ *
+ * of FORCESNLPsolver_model_1 with respect to z = [F s x y v theta].
+ * Same arguments as FORCESNLPsolver_model_1 (z, p, l, y), except that 
+ * arg[1] holds the objective weights [a b1 b2] or is 0 for the generated 
+ * ones; the single result holds the 18 nonzeros of the Hessian in the sparsity s0 below.
+ * Passing arg[3] = 0 drops the dynamics, which gives the Hessian of the
+ * terminal stage FORCESNLPsolver_model_terminal.
+ *
+ * The dynamics are one RK4 step of length h of
+ *
+ *     dx = v cos(theta), dy = v sin(theta), dv = F/m, dtheta = s v/L.
+ *
+ * Since dv does not depend on the state, sub-step i of the RK4 step
+ * evaluates the right hand side at
+ *
+ *     V_i     = v + cv_i F,
+ *     Theta_i = theta + ct_i s (v + cq_i F),
+ *
+ * and the Hessian of y0*c0 + y1*c1 is the weighted sum over i of the
+ * Hessians of V_i (y0 cos(Theta_i) + y1 sin(Theta_i)). c2 is linear and
+ * c3 is bilinear in s and (v, F). Only F, s, v and theta enter
+ * nonlinearly, so apart from the diagonal entries of x and y coming from
+ * h the Hessian is a dense 4x4 block.
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef CODEGEN_PREFIX
+#define NAMESPACE_CONCAT(NS, ID) _NAMESPACE_CONCAT(NS, ID)
+#define _NAMESPACE_CONCAT(NS, ID) NS ## ID
+#define CASADI_PREFIX(ID) NAMESPACE_CONCAT(CODEGEN_PREFIX, ID)
+#else /* CODEGEN_PREFIX */
+#define CASADI_PREFIX(ID) FORCESNLPsolver_model_1_hess_ ## ID
+#endif /* CODEGEN_PREFIX */
+
+#include <math.h>
+
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+/* model constants, as in FORCESNLPsolver_model_1 */
+#define STEP        (1.0000000000000001e-001)    /* RK4 step h             */
+#define MASS        (9.0000000000000002e-001)    /* m                      */
+#define LENGTH      (1.2000000000000000e-001)    /* L                      */
+#define WEIGHT_F    (1.0000000000000001e-001)    /* objective weight of F  */
+#define WEIGHT_S    (1.0000000000000000e-002)    /* objective weight of s  */
+
+/* Hessian sparsity: columns F, s, v, theta have rows F, s, v, theta,
+ * columns x and y only their diagonal entry */
+static const solver_int32_default CASADI_PREFIX(s0)[] = {6, 6, 0, 4, 8, 9, 10, 14, 18, 0, 1, 4, 5, 0, 1, 4, 5, 2, 3, 0, 1, 4, 5, 0, 1, 4, 5};
+#define s0 CASADI_PREFIX(s0)
+
+/* RK4 sub-steps: weights and coefficients of V_i and Theta_i */
+static const FORCESNLPsolver_float CASADI_PREFIX(w)[] = {1., 2., 2., 1.};
+static const FORCESNLPsolver_float CASADI_PREFIX(cv)[] = {0., 0.5*STEP/MASS, 0.5*STEP/MASS, STEP/MASS};
+static const FORCESNLPsolver_float CASADI_PREFIX(ct)[] = {0., 0.5*STEP/LENGTH, 0.5*STEP/LENGTH, STEP/LENGTH};
+static const FORCESNLPsolver_float CASADI_PREFIX(cq)[] = {0., 0., 0.5*STEP/MASS, 0.5*STEP/MASS};
+#define w CASADI_PREFIX(w)
+#define cv CASADI_PREFIX(cv)
+#define ct CASADI_PREFIX(ct)
+#define cq CASADI_PREFIX(cq)
+
+/* evaluate_stages */
+solver_int32_default FORCESNLPsolver_model_1_hess(const FORCESNLPsolver_float **arg, FORCESNLPsolver_float **res)
+{
+    /* dense Hessian block in the variables u = [F s v theta] */
+    FORCESNLPsolver_float H[4][4];
+    FORCESNLPsolver_float gv[4], gt[4];
+    FORCESNLPsolver_float F, s, v, theta, l0, l1, y0, y1, y3;
+    FORCESNLPsolver_float V, T, g1, g2;
+    solver_int32_default i, j, k;
+
+    F = arg[0][0];
+    s = arg[0][1];
+    v = arg[0][4];
+    theta = arg[0][5];
+    l0 = arg[2] ? arg[2][0] : 0;
+    l1 = arg[2] ? arg[2][1] : 0;
+
+    for( i=0; i<4; i++ )
+    {
+        for( j=0; j<4; j++ )
+        {
+            H[i][j] = 0;
+        }
+    }
+
+    /* objective */
+    H[0][0] = 2.*(arg[1] ? arg[1][1] : WEIGHT_F);
+    H[1][1] = 2.*(arg[1] ? arg[1][2] : WEIGHT_S);
+
+    /* dynamics */
+    if( arg[3] )
+    {
+        y0 = arg[3][0];
+        y1 = arg[3][1];
+        y3 = arg[3][3];
+
+        for( k=0; k<4; k++ )
+        {
+            V = v + cv[k]*F;
+            T = theta + ct[k]*s*(v + cq[k]*F);
+
+            /* first and second derivative of y0 cos(T) + y1 sin(T),
+             * scaled by the RK4 weight */
+            g1 = w[k]*STEP/6.*(y1*cos(T) - y0*sin(T));
+            g2 = -w[k]*STEP/6.*(y0*cos(T) + y1*sin(T));
+
+            /* gradients of V_i and Theta_i */
+            gv[0] = cv[k];
+            gv[1] = 0;
+            gv[2] = 1.;
+            gv[3] = 0;
+            gt[0] = ct[k]*s*cq[k];
+            gt[1] = ct[k]*(v + cq[k]*F);
+            gt[2] = ct[k]*s;
+            gt[3] = 1.;
+
+            for( i=0; i<4; i++ )
+            {
+                for( j=0; j<4; j++ )
+                {
+                    H[i][j] += g1*(gv[i]*gt[j] + gt[i]*gv[j]) + V*g2*gt[i]*gt[j];
+                }
+            }
+
+            /* Hessian of Theta_i */
+            H[0][1] += V*g1*ct[k]*cq[k];
+            H[1][0] += V*g1*ct[k]*cq[k];
+            H[1][2] += V*g1*ct[k];
+            H[2][1] += V*g1*ct[k];
+        }
+
+        /* c3 = theta + h/(6L) s (6 v + 3 h F/m) */
+        H[1][2] += y3*STEP/LENGTH;
+        H[2][1] += y3*STEP/LENGTH;
+        H[0][1] += y3*0.5*STEP*STEP/(LENGTH*MASS);
+        H[1][0] += y3*0.5*STEP*STEP/(LENGTH*MASS);
+    }
+
+    /* columns F and s */
+    for( j=0; j<2; j++ )
+    {
+        for( i=0; i<4; i++ )
+        {
+            res[0][4*j + i] = H[i][j];
+        }
+    }
+
+    /* inequalities, columns x and y */
+    res[0][8] = 2.*(l0 + l1);
+    res[0][9] = 2.*(l0 + l1);
+
+    /* columns v and theta */
+    for( j=2; j<4; j++ )
+    {
+        for( i=0; i<4; i++ )
+        {
+            res[0][2 + 4*j + i] = H[i][j];
+        }
+    }
+
+    return 0;
+}
+
+solver_int32_default FORCESNLPsolver_model_1_hess_sparsity(solver_int32_default i, solver_int32_default *nrow, solver_int32_default *ncol, const solver_int32_default **colind, const solver_int32_default **row)
+{
+    const solver_int32_default* s;
+    switch (i)
+    {
+        case 0:
+        s = s0;
+        break;
+        default:
+        return 1;
+    }
+    *nrow = s[0];
+    *ncol = s[1];
+    *colind = s + 2;
+    *row = s + 2 + (*ncol + 1);
+    return 0;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,752 @@
+/* 
+ * SIMD version of FORCESNLPsolver_model_1, evaluates FORCESNLPsolver_SIMD_WIDTH 
+ * stages per call. The arithmetic is the one generated by CasADi for
+ * FORCESNLPsolver_model_1, in the same order, so results only differ 
+ * in the last bits of sin and cos. Only FORCESNLPsolver_casadi2forces_allstages 
+ * calls it, the per-stage callback of the solver uses the scalar kernel. 
+ * tests/test_simd.c compares both.
+ *
+ * Data layout is structure of arrays: entry i of stage (lane) j of an 
+ * argument or result is located at arg[k][i*FORCESNLPsolver_SIMD_WIDTH + j].
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef CODEGEN_PREFIX
+#define NAMESPACE_CONCAT(NS, ID) _NAMESPACE_CONCAT(NS, ID)
+#define _NAMESPACE_CONCAT(NS, ID) NS ## ID
+#define CASADI_PREFIX(ID) NAMESPACE_CONCAT(CODEGEN_PREFIX, ID)
+#else /* CODEGEN_PREFIX */
+#define CASADI_PREFIX(ID) FORCESNLPsolver_model_1_simd_ ## ID
+#endif /* CODEGEN_PREFIX */
+
+#include <math.h>
+
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+#define W FORCESNLPsolver_SIMD_WIDTH
+
+#if FORCESNLPsolver_SIMD_WIDTH == 16 && defined(FORCESNLPsolver_SINGLE_PRECISION_MODELS)
+#ifndef __AVX512F__
+#error "FORCESNLPsolver_SIMD_WIDTH 16 requires AVX-512 (compile with -mavx512f)"
+#endif
+#include <immintrin.h>
+typedef __m512 simd_t;
+typedef __mmask16 simd_mask_t;
+#define VSET1(a) _mm512_set1_ps(a)
+#define VLOAD(p) _mm512_loadu_ps(p)
+#define VSTORE(p, a) _mm512_storeu_ps(p, a)
+#define VADD(a, b) _mm512_add_ps(a, b)
+#define VSUB(a, b) _mm512_sub_ps(a, b)
+#define VMUL(a, b) _mm512_mul_ps(a, b)
+#define VDIV(a, b) _mm512_div_ps(a, b)
+#define VFLOOR(a) _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)
+#define VLT(a, b) _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ)
+#define VEQ(a, b) _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ)
+#define VOR(m1, m2) ((simd_mask_t)((m1) | (m2)))
+#define VSEL(m, a, b) _mm512_mask_blend_ps(m, b, a)
+
+#elif FORCESNLPsolver_SIMD_WIDTH == 8 && defined(FORCESNLPsolver_SINGLE_PRECISION_MODELS)
+#ifndef __AVX__
+#error "FORCESNLPsolver_SIMD_WIDTH 8 requires AVX (compile with -mavx or -mavx2)"
+#endif
+#include <immintrin.h>
+typedef __m256 simd_t;
+typedef __m256 simd_mask_t;
+#define VSET1(a) _mm256_set1_ps(a)
+#define VLOAD(p) _mm256_loadu_ps(p)
+#define VSTORE(p, a) _mm256_storeu_ps(p, a)
+#define VADD(a, b) _mm256_add_ps(a, b)
+#define VSUB(a, b) _mm256_sub_ps(a, b)
+#define VMUL(a, b) _mm256_mul_ps(a, b)
+#define VDIV(a, b) _mm256_div_ps(a, b)
+#define VFLOOR(a) _mm256_floor_ps(a)
+#define VLT(a, b) _mm256_cmp_ps(a, b, _CMP_LT_OQ)
+#define VEQ(a, b) _mm256_cmp_ps(a, b, _CMP_EQ_OQ)
+#define VOR(m1, m2) _mm256_or_ps(m1, m2)
+#define VSEL(m, a, b) _mm256_blendv_ps(b, a, m)
+
+#elif FORCESNLPsolver_SIMD_WIDTH == 8 && !defined(FORCESNLPsolver_SINGLE_PRECISION_MODELS)
+#ifndef __AVX512F__
+#error "FORCESNLPsolver_SIMD_WIDTH 8 requires AVX-512 (compile with -mavx512f)"
+#endif
+#include <immintrin.h>
+typedef __m512d simd_t;
+typedef __mmask8 simd_mask_t;
+#define VSET1(a) _mm512_set1_pd(a)
+#define VLOAD(p) _mm512_loadu_pd(p)
+#define VSTORE(p, a) _mm512_storeu_pd(p, a)
+#define VADD(a, b) _mm512_add_pd(a, b)
+#define VSUB(a, b) _mm512_sub_pd(a, b)
+#define VMUL(a, b) _mm512_mul_pd(a, b)
+#define VDIV(a, b) _mm512_div_pd(a, b)
+#define VFLOOR(a) _mm512_roundscale_pd(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)
+#define VLT(a, b) _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ)
+#define VEQ(a, b) _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ)
+#define VOR(m1, m2) ((simd_mask_t)((m1) | (m2)))
+#define VSEL(m, a, b) _mm512_mask_blend_pd(m, b, a)
+
+#elif FORCESNLPsolver_SIMD_WIDTH == 4 && !defined(FORCESNLPsolver_SINGLE_PRECISION_MODELS)
+#ifndef __AVX__
+#error "FORCESNLPsolver_SIMD_WIDTH 4 requires AVX (compile with -mavx or -mavx2)"
+#endif
+#include <immintrin.h>
+typedef __m256d simd_t;
+typedef __m256d simd_mask_t;
+#define VSET1(a) _mm256_set1_pd(a)
+#define VLOAD(p) _mm256_loadu_pd(p)
+#define VSTORE(p, a) _mm256_storeu_pd(p, a)
+#define VADD(a, b) _mm256_add_pd(a, b)
+#define VSUB(a, b) _mm256_sub_pd(a, b)
+#define VMUL(a, b) _mm256_mul_pd(a, b)
+#define VDIV(a, b) _mm256_div_pd(a, b)
+#define VFLOOR(a) _mm256_floor_pd(a)
+#define VLT(a, b) _mm256_cmp_pd(a, b, _CMP_LT_OQ)
+#define VEQ(a, b) _mm256_cmp_pd(a, b, _CMP_EQ_OQ)
+#define VOR(m1, m2) _mm256_or_pd(m1, m2)
+#define VSEL(m, a, b) _mm256_blendv_pd(b, a, m)
+
+#elif FORCESNLPsolver_SIMD_WIDTH == 1
+/* scalar fallback, identical to FORCESNLPsolver_model_1 */
+typedef FORCESNLPsolver_stage_float simd_t;
+#define VSET1(a) ((FORCESNLPsolver_stage_float)(a))
+#define VLOAD(p) (*(p))
+#define VSTORE(p, a) (*(p) = (a))
+#define VADD(a, b) ((a)+(b))
+#define VSUB(a, b) ((a)-(b))
+#define VMUL(a, b) ((a)*(b))
+#define VDIV(a, b) ((a)/(b))
+
+#else
+#error "FORCESNLPsolver_SIMD_WIDTH must be 1, 4 or 8 (1, 8 or 16 with single precision models)"
+#endif
+
+#define VSQ(a) VMUL(a, a)
+#define VNEG(a) VMUL(VSET1(-1.), a)
+
+#if FORCESNLPsolver_SIMD_WIDTH > 1
+/* vectorized sine and cosine, Cephes polynomials with three-part 
+ * Cody-Waite reduction by pi/4. Accurate to about one ulp. */
+#ifdef FORCESNLPsolver_SINGLE_PRECISION_MODELS
+#define SINCOS_TERMS (3)
+static const FORCESNLPsolver_stage_float CASADI_PREFIX(sincof)[] = {-1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f};
+static const FORCESNLPsolver_stage_float CASADI_PREFIX(coscof)[] = {2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f};
+#define DP1 (7.8515625e-1f)
+#define DP2 (2.4187564849853515625e-4f)
+#define DP3 (3.77489497744594108e-8f)
+#else
+#define SINCOS_TERMS (6)
+static const FORCESNLPsolver_stage_float CASADI_PREFIX(sincof)[] = {1.58962301576546568060e-10, -2.50507477628578072866e-8, 2.75573136213857245213e-6, -1.98412698295895385996e-4, 8.33333333332211858878e-3, -1.66666666666666307295e-1};
+static const FORCESNLPsolver_stage_float CASADI_PREFIX(coscof)[] = {-1.13585365213876817300e-11, 2.08757008419747316778e-9, -2.75573141792967388112e-7, 2.48015872888517045348e-5, -1.38888888888730564116e-3, 4.16666666666665929218e-2};
+#define DP1 (7.85398125648498535156e-1)
+#define DP2 (3.77489470793079817668e-8)
+#define DP3 (2.69515142907905952645e-15)
+#endif
+#define sincof CASADI_PREFIX(sincof)
+#define coscof CASADI_PREFIX(coscof)
+
+static void CASADI_PREFIX(sincos)(simd_t x, simd_t *s, simd_t *c)
+{
+    simd_t xa, y, j, z, zz, ps, pc, sn, cs;
+    simd_mask_t neg, swap;
+    solver_int32_default i;
+    
+    /* sin is odd, work with |x| */
+    neg = VLT(x, VSET1(0.));
+    xa = VSEL(neg, VNEG(x), x);
+    
+    /* octant, rounded up to an even number */
+    y = VFLOOR(VMUL(xa, VSET1(1.27323954473516268615)));
+    y = VADD(y, VSUB(y, VMUL(VSET1(2.), VFLOOR(VMUL(y, VSET1(0.5))))));
+    j = VSUB(y, VMUL(VSET1(8.), VFLOOR(VMUL(y, VSET1(0.125)))));
+    
+    /* extended precision modular arithmetic */
+    z = VSUB(VSUB(VSUB(xa, VMUL(y, VSET1(DP1))), VMUL(y, VSET1(DP2))), VMUL(y, VSET1(DP3)));
+    zz = VMUL(z, z);
+    
+    ps = VSET1(sincof[0]);
+    pc = VSET1(coscof[0]);
+    for( i=1; i<SINCOS_TERMS; i++ )
+    {
+        ps = VADD(VMUL(ps, zz), VSET1(sincof[i]));
+        pc = VADD(VMUL(pc, zz), VSET1(coscof[i]));
+    }
+    ps = VADD(z, VMUL(VMUL(z, zz), ps));
+    pc = VADD(VSUB(VSET1(1.), VMUL(zz, VSET1(0.5))), VMUL(VMUL(zz, zz), pc));
+    
+    /* octants 2 and 6 swap sine and cosine */
+    swap = VOR(VEQ(j, VSET1(2.)), VEQ(j, VSET1(6.)));
+    sn = VSEL(swap, pc, ps);
+    cs = VSEL(swap, ps, pc);
+    
+    /* sine is negative in octants 4 and 6, cosine in octants 2 and 4 */
+    sn = VSEL(VLT(j, VSET1(4.)), sn, VNEG(sn));
+    cs = VSEL(VOR(VEQ(j, VSET1(2.)), VEQ(j, VSET1(4.))), VNEG(cs), cs);
+    
+    *s = VSEL(neg, VNEG(sn), sn);
+    *c = cs;
+}
+#define vsincos(x, s, c) CASADI_PREFIX(sincos)(x, s, c)
+#else
+#define vsincos(x, s, c) (*(s) = sin(x), *(c) = cos(x))
+#endif
+
+/* evaluate_stages, FORCESNLPsolver_SIMD_WIDTH at a time. arg[0] must not be NULL. */
+solver_int32_default FORCESNLPsolver_model_1_simd(const FORCESNLPsolver_stage_float **arg, FORCESNLPsolver_stage_float **res) 
+{
+    simd_t a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32;
+    simd_t sn0,cs0,sn1,cs1,sn2,cs2,sn3,cs3;
+    
+    a0=VSET1(-100.);
+    a1=VLOAD(arg[0]+3*W);
+    a2=VMUL(a0,a1);
+    a3=VLOAD(arg[0]+0*W);
+    a4=VSQ(a3);
+    a5=VSET1(1.0000000000000001e-001);
+    a4=VMUL(a5,a4);
+    a2=VADD(a2,a4);
+    a4=VLOAD(arg[0]+1*W);
+    a6=VSQ(a4);
+    a7=VSET1(1.0000000000000000e-002);
+    a6=VMUL(a7,a6);
+    a2=VADD(a2,a6);
+    if (res[0]!=0) VSTORE(res[0]+0*W,a2);
+    a2=VADD(a3,a3);
+    a2=VMUL(a5,a2);
+    if (res[1]!=0) VSTORE(res[1]+0*W,a2);
+    a2=VADD(a4,a4);
+    a7=VMUL(a7,a2);
+    if (res[1]!=0) VSTORE(res[1]+1*W,a7);
+    if (res[1]!=0) VSTORE(res[1]+2*W,a0);
+    a0=VLOAD(arg[0]+2*W);
+    a7=VSQ(a0);
+    a2=VSQ(a1);
+    a7=VADD(a7,a2);
+    if (res[2]!=0) VSTORE(res[2]+0*W,a7);
+    a7=VSET1(2.);
+    a2=VADD(a0,a7);
+    a6=VSQ(a2);
+    a8=VSET1(2.5000000000000000e+000);
+    a8=VSUB(a1,a8);
+    a9=VSQ(a8);
+    a6=VADD(a6,a9);
+    if (res[2]!=0) VSTORE(res[2]+1*W,a6);
+    a6=VADD(a0,a0);
+    if (res[3]!=0) VSTORE(res[3]+0*W,a6);
+    a2=VADD(a2,a2);
+    if (res[3]!=0) VSTORE(res[3]+1*W,a2);
+    a2=VADD(a1,a1);
+    if (res[3]!=0) VSTORE(res[3]+2*W,a2);
+    a8=VADD(a8,a8);
+    if (res[3]!=0) VSTORE(res[3]+3*W,a8);
+    a8=VLOAD(arg[0]+5*W);
+    vsincos(a8, &sn0, &cs0);
+    a2=cs0;
+    a6=VLOAD(arg[0]+4*W);
+    a9=VMUL(a6,a2);
+    a10=VSET1(9.0000000000000002e-001);
+    a11=VDIV(a3,a10);
+    a12=VSET1(5.0000000000000003e-002);
+    a13=VMUL(a12,a11);
+    a13=VADD(a6,a13);
+    a14=VMUL(a4,a6);
+    a15=VSET1(1.2000000000000000e-001);
+    a14=VDIV(a14,a15);
+    a16=VMUL(a12,a14);
+    a16=VADD(a8,a16);
+    vsincos(a16, &sn1, &cs1);
+    a17=cs1;
+    a18=VMUL(a13,a17);
+    a18=VMUL(a7,a18);
+    a9=VADD(a9,a18);
+    a18=VDIV(a3,a10);
+    a19=VMUL(a12,a18);
+    a19=VADD(a6,a19);
+    a20=VMUL(a4,a13);
+    a20=VDIV(a20,a15);
+    a21=VMUL(a12,a20);
+    a21=VADD(a8,a21);
+    vsincos(a21, &sn2, &cs2);
+    a22=cs2;
+    a23=VMUL(a19,a22);
+    a23=VMUL(a7,a23);
+    a9=VADD(a9,a23);
+    a23=VDIV(a3,a10);
+    a24=VMUL(a5,a23);
+    a24=VADD(a6,a24);
+    a25=VMUL(a4,a19);
+    a25=VDIV(a25,a15);
+    a26=VMUL(a5,a25);
+    a26=VADD(a8,a26);
+    vsincos(a26, &sn3, &cs3);
+    a27=cs3;
+    a28=VMUL(a24,a27);
+    a9=VADD(a9,a28);
+    a28=VSET1(1.6666666666666666e-002);
+    a9=VMUL(a28,a9);
+    a0=VADD(a0,a9);
+    if (res[4]!=0) VSTORE(res[4]+0*W,a0);
+    a0=sn0;
+    a9=VMUL(a6,a0);
+    a29=sn1;
+    a30=VMUL(a13,a29);
+    a30=VMUL(a7,a30);
+    a9=VADD(a9,a30);
+    a30=sn2;
+    a31=VMUL(a19,a30);
+    a31=VMUL(a7,a31);
+    a9=VADD(a9,a31);
+    a31=sn3;
+    a32=VMUL(a24,a31);
+    a9=VADD(a9,a32);
+    a9=VMUL(a28,a9);
+    a1=VADD(a1,a9);
+    if (res[4]!=0) VSTORE(res[4]+1*W,a1);
+    a18=VMUL(a7,a18);
+    a11=VADD(a11,a18);
+    a23=VMUL(a7,a23);
+    a11=VADD(a11,a23);
+    a3=VDIV(a3,a10);
+    a11=VADD(a11,a3);
+    a11=VMUL(a28,a11);
+    a11=VADD(a6,a11);
+    if (res[4]!=0) VSTORE(res[4]+2*W,a11);
+    a20=VMUL(a7,a20);
+    a14=VADD(a14,a20);
+    a25=VMUL(a7,a25);
+    a14=VADD(a14,a25);
+    a25=VMUL(a4,a24);
+    a25=VDIV(a25,a15);
+    a14=VADD(a14,a25);
+    a14=VMUL(a28,a14);
+    a14=VADD(a8,a14);
+    if (res[4]!=0) VSTORE(res[4]+3*W,a14);
+    a14=VSET1(5.5555555555555559e-002);
+    a25=VMUL(a14,a17);
+    a25=VMUL(a7,a25);
+    a15=VMUL(a14,a22);
+    a20=VMUL(a14,a4);
+    a11=VSET1(8.3333333333333339e+000);
+    a20=VMUL(a11,a20);
+    a3=VMUL(a12,a20);
+    a10=sn2;
+    a23=VMUL(a10,a3);
+    a23=VMUL(a19,a23);
+    a15=VSUB(a15,a23);
+    a15=VMUL(a7,a15);
+    a25=VADD(a25,a15);
+    a15=VSET1(1.1111111111111112e-001);
+    a23=VMUL(a15,a27);
+    a18=VMUL(a14,a4);
+    a18=VMUL(a11,a18);
+    a1=VMUL(a5,a18);
+    a9=sn3;
+    a32=VMUL(a9,a1);
+    a32=VMUL(a24,a32);
+    a23=VSUB(a23,a32);
+    a25=VADD(a25,a23);
+    a25=VMUL(a28,a25);
+    if (res[5]!=0) VSTORE(res[5]+0*W,a25);
+    a25=VMUL(a14,a29);
+    a25=VMUL(a7,a25);
+    a14=VMUL(a14,a30);
+    a21=cs2;
+    a3=VMUL(a21,a3);
+    a3=VMUL(a19,a3);
+    a14=VADD(a14,a3);
+    a14=VMUL(a7,a14);
+    a25=VADD(a25,a14);
+    a14=VMUL(a15,a31);
+    a26=cs3;
+    a1=VMUL(a26,a1);
+    a1=VMUL(a24,a1);
+    a14=VADD(a14,a1);
+    a25=VADD(a25,a14);
+    a25=VMUL(a28,a25);
+    if (res[5]!=0) VSTORE(res[5]+1*W,a25);
+    a25=VSET1(1.1111111111111110e-001);
+    if (res[5]!=0) VSTORE(res[5]+2*W,a25);
+    a20=VMUL(a7,a20);
+    a18=VMUL(a7,a18);
+    a20=VADD(a20,a18);
+    a15=VMUL(a15,a4);
+    a15=VMUL(a11,a15);
+    a20=VADD(a20,a15);
+    a20=VMUL(a28,a20);
+    if (res[5]!=0) VSTORE(res[5]+3*W,a20);
+    a20=VMUL(a11,a6);
+    a15=VMUL(a12,a20);
+    a18=sn1;
+    a25=VMUL(a18,a15);
+    a25=VMUL(a13,a25);
+    a25=VMUL(a7,a25);
+    a14=VMUL(a11,a13);
+    a1=VMUL(a12,a14);
+    a3=VMUL(a10,a1);
+    a3=VMUL(a19,a3);
+    a3=VMUL(a7,a3);
+    a25=VADD(a25,a3);
+    a3=VMUL(a11,a19);
+    a23=VMUL(a5,a3);
+    a32=VMUL(a9,a23);
+    a32=VMUL(a24,a32);
+    a25=VADD(a25,a32);
+    a25=VMUL(a28,a25);
+    a25=VNEG(a25);
+    if (res[5]!=0) VSTORE(res[5]+4*W,a25);
+    a16=cs1;
+    a15=VMUL(a16,a15);
+    a15=VMUL(a13,a15);
+    a15=VMUL(a7,a15);
+    a1=VMUL(a21,a1);
+    a1=VMUL(a19,a1);
+    a1=VMUL(a7,a1);
+    a15=VADD(a15,a1);
+    a23=VMUL(a26,a23);
+    a23=VMUL(a24,a23);
+    a15=VADD(a15,a23);
+    a15=VMUL(a28,a15);
+    if (res[5]!=0) VSTORE(res[5]+5*W,a15);
+    a14=VMUL(a7,a14);
+    a20=VADD(a20,a14);
+    a3=VMUL(a7,a3);
+    a20=VADD(a20,a3);
+    a3=VMUL(a11,a24);
+    a20=VADD(a20,a3);
+    a20=VMUL(a28,a20);
+    if (res[5]!=0) VSTORE(res[5]+6*W,a20);
+    a20=VSET1(1.);
+    if (res[5]!=0) VSTORE(res[5]+7*W,a20);
+    if (res[5]!=0) VSTORE(res[5]+8*W,a20);
+    a3=VMUL(a11,a4);
+    a14=VMUL(a12,a3);
+    a15=VMUL(a18,a14);
+    a15=VMUL(a13,a15);
+    a17=VSUB(a17,a15);
+    a17=VMUL(a7,a17);
+    a2=VADD(a2,a17);
+    a17=VMUL(a11,a4);
+    a12=VMUL(a12,a17);
+    a15=VMUL(a10,a12);
+    a15=VMUL(a19,a15);
+    a22=VSUB(a22,a15);
+    a22=VMUL(a7,a22);
+    a2=VADD(a2,a22);
+    a22=VMUL(a11,a4);
+    a5=VMUL(a5,a22);
+    a15=VMUL(a9,a5);
+    a15=VMUL(a24,a15);
+    a27=VSUB(a27,a15);
+    a2=VADD(a2,a27);
+    a2=VMUL(a28,a2);
+    if (res[5]!=0) VSTORE(res[5]+9*W,a2);
+    a14=VMUL(a16,a14);
+    a14=VMUL(a13,a14);
+    a29=VADD(a29,a14);
+    a29=VMUL(a7,a29);
+    a0=VADD(a0,a29);
+    a12=VMUL(a21,a12);
+    a12=VMUL(a19,a12);
+    a30=VADD(a30,a12);
+    a30=VMUL(a7,a30);
+    a0=VADD(a0,a30);
+    a5=VMUL(a26,a5);
+    a5=VMUL(a24,a5);
+    a31=VADD(a31,a5);
+    a0=VADD(a0,a31);
+    a0=VMUL(a28,a0);
+    if (res[5]!=0) VSTORE(res[5]+10*W,a0);
+    if (res[5]!=0) VSTORE(res[5]+11*W,a20);
+    a17=VMUL(a7,a17);
+    a3=VADD(a3,a17);
+    a22=VMUL(a7,a22);
+    a3=VADD(a3,a22);
+    a11=VMUL(a11,a4);
+    a3=VADD(a3,a11);
+    a3=VMUL(a28,a3);
+    if (res[5]!=0) VSTORE(res[5]+12*W,a3);
+    a3=sn0;
+    a3=VMUL(a6,a3);
+    a18=VMUL(a13,a18);
+    a18=VMUL(a7,a18);
+    a3=VADD(a3,a18);
+    a10=VMUL(a19,a10);
+    a10=VMUL(a7,a10);
+    a3=VADD(a3,a10);
+    a9=VMUL(a24,a9);
+    a3=VADD(a3,a9);
+    a3=VMUL(a28,a3);
+    a3=VNEG(a3);
+    if (res[5]!=0) VSTORE(res[5]+13*W,a3);
+    a8=cs0;
+    a6=VMUL(a6,a8);
+    a13=VMUL(a13,a16);
+    a13=VMUL(a7,a13);
+    a6=VADD(a6,a13);
+    a19=VMUL(a19,a21);
+    a7=VMUL(a7,a19);
+    a6=VADD(a6,a7);
+    a24=VMUL(a24,a26);
+    a6=VADD(a6,a24);
+    a28=VMUL(a28,a6);
+    if (res[5]!=0) VSTORE(res[5]+14*W,a28);
+    if (res[5]!=0) VSTORE(res[5]+15*W,a20);
+    return 0;
+}
+
+/* evaluate_stages, FORCESNLPsolver_SIMD_WIDTH at a time, values only: f, h and c */
+solver_int32_default FORCESNLPsolver_model_1_simd_val(const FORCESNLPsolver_stage_float **arg, FORCESNLPsolver_stage_float **res) 
+{
+    simd_t a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32;
+    simd_t sn0,cs0,sn1,cs1,sn2,cs2,sn3,cs3;
+    
+    a0=VSET1(-100.);
+    a1=VLOAD(arg[0]+3*W);
+    a2=VMUL(a0,a1);
+    a3=VLOAD(arg[0]+0*W);
+    a4=VSQ(a3);
+    a5=VSET1(1.0000000000000001e-001);
+    a4=VMUL(a5,a4);
+    a2=VADD(a2,a4);
+    a4=VLOAD(arg[0]+1*W);
+    a6=VSQ(a4);
+    a7=VSET1(1.0000000000000000e-002);
+    a6=VMUL(a7,a6);
+    a2=VADD(a2,a6);
+    if (res[0]!=0) VSTORE(res[0]+0*W,a2);
+    a0=VLOAD(arg[0]+2*W);
+    a7=VSQ(a0);
+    a2=VSQ(a1);
+    a7=VADD(a7,a2);
+    if (res[2]!=0) VSTORE(res[2]+0*W,a7);
+    a7=VSET1(2.);
+    a2=VADD(a0,a7);
+    a6=VSQ(a2);
+    a8=VSET1(2.5000000000000000e+000);
+    a8=VSUB(a1,a8);
+    a9=VSQ(a8);
+    a6=VADD(a6,a9);
+    if (res[2]!=0) VSTORE(res[2]+1*W,a6);
+    a8=VLOAD(arg[0]+5*W);
+    vsincos(a8, &sn0, &cs0);
+    a2=cs0;
+    a6=VLOAD(arg[0]+4*W);
+    a9=VMUL(a6,a2);
+    a10=VSET1(9.0000000000000002e-001);
+    a11=VDIV(a3,a10);
+    a12=VSET1(5.0000000000000003e-002);
+    a13=VMUL(a12,a11);
+    a13=VADD(a6,a13);
+    a14=VMUL(a4,a6);
+    a15=VSET1(1.2000000000000000e-001);
+    a14=VDIV(a14,a15);
+    a16=VMUL(a12,a14);
+    a16=VADD(a8,a16);
+    vsincos(a16, &sn1, &cs1);
+    a17=cs1;
+    a18=VMUL(a13,a17);
+    a18=VMUL(a7,a18);
+    a9=VADD(a9,a18);
+    a18=VDIV(a3,a10);
+    a19=VMUL(a12,a18);
+    a19=VADD(a6,a19);
+    a20=VMUL(a4,a13);
+    a20=VDIV(a20,a15);
+    a21=VMUL(a12,a20);
+    a21=VADD(a8,a21);
+    vsincos(a21, &sn2, &cs2);
+    a22=cs2;
+    a23=VMUL(a19,a22);
+    a23=VMUL(a7,a23);
+    a9=VADD(a9,a23);
+    a23=VDIV(a3,a10);
+    a24=VMUL(a5,a23);
+    a24=VADD(a6,a24);
+    a25=VMUL(a4,a19);
+    a25=VDIV(a25,a15);
+    a26=VMUL(a5,a25);
+    a26=VADD(a8,a26);
+    vsincos(a26, &sn3, &cs3);
+    a27=cs3;
+    a28=VMUL(a24,a27);
+    a9=VADD(a9,a28);
+    a28=VSET1(1.6666666666666666e-002);
+    a9=VMUL(a28,a9);
+    a0=VADD(a0,a9);
+    if (res[4]!=0) VSTORE(res[4]+0*W,a0);
+    a0=sn0;
+    a9=VMUL(a6,a0);
+    a29=sn1;
+    a30=VMUL(a13,a29);
+    a30=VMUL(a7,a30);
+    a9=VADD(a9,a30);
+    a30=sn2;
+    a31=VMUL(a19,a30);
+    a31=VMUL(a7,a31);
+    a9=VADD(a9,a31);
+    a31=sn3;
+    a32=VMUL(a24,a31);
+    a9=VADD(a9,a32);
+    a9=VMUL(a28,a9);
+    a1=VADD(a1,a9);
+    if (res[4]!=0) VSTORE(res[4]+1*W,a1);
+    a18=VMUL(a7,a18);
+    a11=VADD(a11,a18);
+    a23=VMUL(a7,a23);
+    a11=VADD(a11,a23);
+    a3=VDIV(a3,a10);
+    a11=VADD(a11,a3);
+    a11=VMUL(a28,a11);
+    a11=VADD(a6,a11);
+    if (res[4]!=0) VSTORE(res[4]+2*W,a11);
+    a20=VMUL(a7,a20);
+    a14=VADD(a14,a20);
+    a25=VMUL(a7,a25);
+    a14=VADD(a14,a25);
+    a25=VMUL(a4,a24);
+    a25=VDIV(a25,a15);
+    a14=VADD(a14,a25);
+    a14=VMUL(a28,a14);
+    a14=VADD(a8,a14);
+    if (res[4]!=0) VSTORE(res[4]+3*W,a14);
+    return 0;
+}
+
+/* evaluate_stages, FORCESNLPsolver_SIMD_WIDTH at a time, values and gradients of f and h, no Jacobian of the dynamics */
+solver_int32_default FORCESNLPsolver_model_1_simd_valgrad(const FORCESNLPsolver_stage_float **arg, FORCESNLPsolver_stage_float **res) 
+{
+    simd_t a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32;
+    simd_t sn0,cs0,sn1,cs1,sn2,cs2,sn3,cs3;
+    
+    a0=VSET1(-100.);
+    a1=VLOAD(arg[0]+3*W);
+    a2=VMUL(a0,a1);
+    a3=VLOAD(arg[0]+0*W);
+    a4=VSQ(a3);
+    a5=VSET1(1.0000000000000001e-001);
+    a4=VMUL(a5,a4);
+    a2=VADD(a2,a4);
+    a4=VLOAD(arg[0]+1*W);
+    a6=VSQ(a4);
+    a7=VSET1(1.0000000000000000e-002);
+    a6=VMUL(a7,a6);
+    a2=VADD(a2,a6);
+    if (res[0]!=0) VSTORE(res[0]+0*W,a2);
+    a2=VADD(a3,a3);
+    a2=VMUL(a5,a2);
+    if (res[1]!=0) VSTORE(res[1]+0*W,a2);
+    a2=VADD(a4,a4);
+    a7=VMUL(a7,a2);
+    if (res[1]!=0) VSTORE(res[1]+1*W,a7);
+    if (res[1]!=0) VSTORE(res[1]+2*W,a0);
+    a0=VLOAD(arg[0]+2*W);
+    a7=VSQ(a0);
+    a2=VSQ(a1);
+    a7=VADD(a7,a2);
+    if (res[2]!=0) VSTORE(res[2]+0*W,a7);
+    a7=VSET1(2.);
+    a2=VADD(a0,a7);
+    a6=VSQ(a2);
+    a8=VSET1(2.5000000000000000e+000);
+    a8=VSUB(a1,a8);
+    a9=VSQ(a8);
+    a6=VADD(a6,a9);
+    if (res[2]!=0) VSTORE(res[2]+1*W,a6);
+    a6=VADD(a0,a0);
+    if (res[3]!=0) VSTORE(res[3]+0*W,a6);
+    a2=VADD(a2,a2);
+    if (res[3]!=0) VSTORE(res[3]+1*W,a2);
+    a2=VADD(a1,a1);
+    if (res[3]!=0) VSTORE(res[3]+2*W,a2);
+    a8=VADD(a8,a8);
+    if (res[3]!=0) VSTORE(res[3]+3*W,a8);
+    a8=VLOAD(arg[0]+5*W);
+    vsincos(a8, &sn0, &cs0);
+    a2=cs0;
+    a6=VLOAD(arg[0]+4*W);
+    a9=VMUL(a6,a2);
+    a10=VSET1(9.0000000000000002e-001);
+    a11=VDIV(a3,a10);
+    a12=VSET1(5.0000000000000003e-002);
+    a13=VMUL(a12,a11);
+    a13=VADD(a6,a13);
+    a14=VMUL(a4,a6);
+    a15=VSET1(1.2000000000000000e-001);
+    a14=VDIV(a14,a15);
+    a16=VMUL(a12,a14);
+    a16=VADD(a8,a16);
+    vsincos(a16, &sn1, &cs1);
+    a17=cs1;
+    a18=VMUL(a13,a17);
+    a18=VMUL(a7,a18);
+    a9=VADD(a9,a18);
+    a18=VDIV(a3,a10);
+    a19=VMUL(a12,a18);
+    a19=VADD(a6,a19);
+    a20=VMUL(a4,a13);
+    a20=VDIV(a20,a15);
+    a21=VMUL(a12,a20);
+    a21=VADD(a8,a21);
+    vsincos(a21, &sn2, &cs2);
+    a22=cs2;
+    a23=VMUL(a19,a22);
+    a23=VMUL(a7,a23);
+    a9=VADD(a9,a23);
+    a23=VDIV(a3,a10);
+    a24=VMUL(a5,a23);
+    a24=VADD(a6,a24);
+    a25=VMUL(a4,a19);
+    a25=VDIV(a25,a15);
+    a26=VMUL(a5,a25);
+    a26=VADD(a8,a26);
+    vsincos(a26, &sn3, &cs3);
+    a27=cs3;
+    a28=VMUL(a24,a27);
+    a9=VADD(a9,a28);
+    a28=VSET1(1.6666666666666666e-002);
+    a9=VMUL(a28,a9);
+    a0=VADD(a0,a9);
+    if (res[4]!=0) VSTORE(res[4]+0*W,a0);
+    a0=sn0;
+    a9=VMUL(a6,a0);
+    a29=sn1;
+    a30=VMUL(a13,a29);
+    a30=VMUL(a7,a30);
+    a9=VADD(a9,a30);
+    a30=sn2;
+    a31=VMUL(a19,a30);
+    a31=VMUL(a7,a31);
+    a9=VADD(a9,a31);
+    a31=sn3;
+    a32=VMUL(a24,a31);
+    a9=VADD(a9,a32);
+    a9=VMUL(a28,a9);
+    a1=VADD(a1,a9);
+    if (res[4]!=0) VSTORE(res[4]+1*W,a1);
+    a18=VMUL(a7,a18);
+    a11=VADD(a11,a18);
+    a23=VMUL(a7,a23);
+    a11=VADD(a11,a23);
+    a3=VDIV(a3,a10);
+    a11=VADD(a11,a3);
+    a11=VMUL(a28,a11);
+    a11=VADD(a6,a11);
+    if (res[4]!=0) VSTORE(res[4]+2*W,a11);
+    a20=VMUL(a7,a20);
+    a14=VADD(a14,a20);
+    a25=VMUL(a7,a25);
+    a14=VADD(a14,a25);
+    a25=VMUL(a4,a24);
+    a25=VDIV(a25,a15);
+    a14=VADD(a14,a25);
+    a14=VMUL(a28,a14);
+    a14=VADD(a8,a14);
+    if (res[4]!=0) VSTORE(res[4]+3*W,a14);
+    return 0;
+}
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
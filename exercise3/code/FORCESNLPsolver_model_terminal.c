@@ -1,4 +1,8 @@
 /* This function was automatically generated by CasADi */
+/* 
+ * Terminal stage model, shared by all horizon lengths: the terminal stage
+ * is the stage FORCESNLPsolver_N - 1 in FORCESNLPsolver_casadi2forces.
+ */
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -8,7 +12,7 @@ extern "C" {
 #define _NAMESPACE_CONCAT(NS, ID) NS ## ID
 #define CASADI_PREFIX(ID) NAMESPACE_CONCAT(CODEGEN_PREFIX, ID)
 #else /* CODEGEN_PREFIX */
-#define CASADI_PREFIX(ID) FORCESNLPsolver_model_38_ ## ID
+#define CASADI_PREFIX(ID) FORCESNLPsolver_model_terminal_ ## ID
 #endif /* CODEGEN_PREFIX */
 
 #include <math.h>
@@ -16,10 +20,10 @@ extern "C" {
 #include "FORCESNLPsolver/include/FORCESNLPsolver.h"
 
 #define PRINTF printf
-FORCESNLPsolver_float CASADI_PREFIX(sq)(FORCESNLPsolver_float x) { return x*x;}
+FORCESNLPsolver_stage_float CASADI_PREFIX(sq)(FORCESNLPsolver_stage_float x) { return x*x;}
 #define sq(x) CASADI_PREFIX(sq)(x)
 
-FORCESNLPsolver_float CASADI_PREFIX(sign)(FORCESNLPsolver_float x) { return x<0 ? -1 : x>0 ? 1 : x;}
+FORCESNLPsolver_stage_float CASADI_PREFIX(sign)(FORCESNLPsolver_stage_float x) { return x<0 ? -1 : x>0 ? 1 : x;}
 #define sign(x) CASADI_PREFIX(sign)(x)
 
 static const solver_int32_default CASADI_PREFIX(s0)[] = {6, 1, 0, 6, 0, 1, 2, 3, 4, 5};
@@ -35,9 +39,9 @@ static const solver_int32_default CASADI_PREFIX(s4)[] = {2, 1, 0, 2, 0, 1};
 static const solver_int32_default CASADI_PREFIX(s5)[] = {2, 6, 0, 0, 0, 2, 4, 4, 4, 0, 1, 0, 1};
 #define s5 CASADI_PREFIX(s5)
 /* evaluate_stages */
-solver_int32_default FORCESNLPsolver_model_38(const FORCESNLPsolver_float **arg, FORCESNLPsolver_float **res) 
+solver_int32_default FORCESNLPsolver_model_terminal(const FORCESNLPsolver_stage_float **arg, FORCESNLPsolver_stage_float **res) 
 {
-    FORCESNLPsolver_float a0,a1,a2,a3,a4,a5,a6,a7;
+    FORCESNLPsolver_stage_float a0,a1,a2,a3,a4,a5,a6,a7;
     
     a0=-100.;
     a1=arg[0] ? arg[0][3] : 0;
@@ -84,7 +88,7 @@ solver_int32_default FORCESNLPsolver_model_38(const FORCESNLPsolver_float **arg,
     return 0;
 }
 
-solver_int32_default FORCESNLPsolver_model_38_init(solver_int32_default *f_type, solver_int32_default *n_in, solver_int32_default *n_out, solver_int32_default *sz_arg, solver_int32_default *sz_res) 
+solver_int32_default FORCESNLPsolver_model_terminal_init(solver_int32_default *f_type, solver_int32_default *n_in, solver_int32_default *n_out, solver_int32_default *sz_arg, solver_int32_default *sz_res) 
 {
     *f_type = 1;
     *n_in = 2;
@@ -94,7 +98,7 @@ solver_int32_default FORCESNLPsolver_model_38_init(solver_int32_default *f_type,
     return 0;
 }
 
-solver_int32_default FORCESNLPsolver_model_38_sparsity(solver_int32_default i, solver_int32_default *nrow, solver_int32_default *ncol, const solver_int32_default **colind, const solver_int32_default **row) 
+solver_int32_default FORCESNLPsolver_model_terminal_sparsity(solver_int32_default i, solver_int32_default *nrow, solver_int32_default *ncol, const solver_int32_default **colind, const solver_int32_default **row) 
 {
     const solver_int32_default *s;
     switch (i) 
@@ -128,7 +132,7 @@ solver_int32_default FORCESNLPsolver_model_38_sparsity(solver_int32_default i, s
     return 0;
 }
 
-solver_int32_default FORCESNLPsolver_model_38_work(solver_int32_default *sz_iw, solver_int32_default *sz_w) 
+solver_int32_default FORCESNLPsolver_model_terminal_work(solver_int32_default *sz_iw, solver_int32_default *sz_w) 
 {
     if (sz_iw) *sz_iw = 0;
     if (sz_w) *sz_w = 8;
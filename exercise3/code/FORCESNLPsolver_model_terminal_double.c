@@ -0,0 +1,17 @@
+/* 
+ * Double precision copy of FORCESNLPsolver_model_terminal for builds with 
+ * single precision stage models (FORCESNLPsolver_SINGLE_PRECISION_MODELS), 
+ * used by FORCESNLPsolver_casadi2forces_precision as the reference. Empty 
+ * otherwise.
+ */
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+#ifdef FORCESNLPsolver_SINGLE_PRECISION_MODELS
+#define CODEGEN_PREFIX FORCESNLPsolver_model_terminal_double_
+#define FORCESNLPsolver_stage_float FORCESNLPsolver_float
+#define FORCESNLPsolver_model_terminal FORCESNLPsolver_model_terminal_double
+#define FORCESNLPsolver_model_terminal_init FORCESNLPsolver_model_terminal_double_init
+#define FORCESNLPsolver_model_terminal_sparsity FORCESNLPsolver_model_terminal_double_sparsity
+#define FORCESNLPsolver_model_terminal_work FORCESNLPsolver_model_terminal_double_work
+#include "FORCESNLPsolver_model_terminal.c"
+#endif
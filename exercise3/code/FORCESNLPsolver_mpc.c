@@ -0,0 +1,177 @@
+/*
+ * Receding horizon control: solves the problem once per sampling instant
+ * for the measured state, warm started from the solution of the previous
+ * instant shifted forward by one stage. The stage that is shifted in at
+ * the end of the horizon is extrapolated with the model dynamics.
+ *
+ * The sampling period is the RK4 step of the model, so the shifted
+ * solution is consistent with the dynamics and typically only needs a few
+ * iterations to become optimal again.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <string.h>
+
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+/* stage model, in double precision also with single precision models */
+#ifdef FORCESNLPsolver_SINGLE_PRECISION_MODELS
+extern void FORCESNLPsolver_model_1_double_val(const FORCESNLPsolver_float **arg, FORCESNLPsolver_float **res);
+#define model_1_val FORCESNLPsolver_model_1_double_val
+#else
+extern void FORCESNLPsolver_model_1_val(const FORCESNLPsolver_float **arg, FORCESNLPsolver_float **res);
+#define model_1_val FORCESNLPsolver_model_1_val
+#endif
+
+/* state after one RK4 step from stage variables z */
+static void dynamics(const FORCESNLPsolver_float *z, FORCESNLPsolver_float *xnext)
+{
+    const FORCESNLPsolver_float *in[4];
+    FORCESNLPsolver_float *out[6];
+
+    in[0] = z;
+    in[1] = 0;
+    in[2] = 0;
+    in[3] = 0;
+    out[0] = 0;
+    out[1] = 0;
+    out[2] = 0;
+    out[3] = 0;
+    out[4] = xnext;
+    out[5] = 0;
+    model_1_val(in, out);
+}
+
+/* initial guess in the middle of the bounds */
+static void cold_start(FORCESNLPsolver_params *params)
+{
+    solver_int32_default k, i;
+
+    for( k=0; k<FORCESNLPsolver_N; k++ )
+    {
+        for( i=0; i<FORCESNLPsolver_NVAR; i++ )
+        {
+            params->x0[k*FORCESNLPsolver_NVAR + i] = FORCESNLPsolver_lb[i] + 0.5*(FORCESNLPsolver_ub[i] - FORCESNLPsolver_lb[i]);
+        }
+    }
+}
+
+/* initial guess from the previous solution shifted by one stage */
+static void shift(FORCESNLPsolver_params *params, const FORCESNLPsolver_output *output, solver_int32_default horizon)
+{
+    /* the stage vectors x001..x100 of the output follow each other */
+    const FORCESNLPsolver_float *z = output->x001;
+    FORCESNLPsolver_float *x0 = params->x0;
+    FORCESNLPsolver_float *last = x0 + (horizon - 1)*FORCESNLPsolver_NVAR;
+    solver_int32_default k, i;
+
+    memcpy(x0, z + FORCESNLPsolver_NVAR, (horizon - 1)*FORCESNLPsolver_NVAR*sizeof(FORCESNLPsolver_float));
+
+    /* new last stage: keep the inputs and step the state forward */
+    last[0] = z[(horizon - 1)*FORCESNLPsolver_NVAR];
+    last[1] = z[(horizon - 1)*FORCESNLPsolver_NVAR + 1];
+    dynamics(z + (horizon - 1)*FORCESNLPsolver_NVAR, last + 2);
+    for( i=0; i<FORCESNLPsolver_NVAR; i++ )
+    {
+        last[i] = last[i] < FORCESNLPsolver_lb[i] ? FORCESNLPsolver_lb[i] : last[i] > FORCESNLPsolver_ub[i] ? FORCESNLPsolver_ub[i] : last[i];
+    }
+
+    /* stages behind the active horizon hold the last state */
+    for( k=horizon; k<FORCESNLPsolver_N; k++ )
+    {
+        x0[k*FORCESNLPsolver_NVAR] = 0;
+        x0[k*FORCESNLPsolver_NVAR + 1] = 0;
+        memcpy(x0 + k*FORCESNLPsolver_NVAR + 2, last + 2, 4*sizeof(FORCESNLPsolver_float));
+    }
+}
+
+/* prepares a controller */
+extern void FORCESNLPsolver_mpc_init(FORCESNLPsolver_mpc *mpc, const FORCESNLPsolver_float *xfinal, solver_int32_default horizon)
+{
+    FORCESNLPsolver_context_init(&mpc->ctx);
+    FORCESNLPsolver_context_set_horizon(&mpc->ctx, horizon);
+    memcpy(mpc->ctx.params.xfinal, xfinal, 2*sizeof(FORCESNLPsolver_float));
+    mpc->warm = 0;
+    mpc->guess = 0;
+    mpc->steps = 0;
+    mpc->fs = 0;
+}
+
+/* solves the problem for the measured state xinit */
+extern solver_int32_default FORCESNLPsolver_mpc_step(FORCESNLPsolver_mpc *mpc, const FORCESNLPsolver_float *xinit, FORCESNLPsolver_mpc_stats *step)
+{
+    FORCESNLPsolver_context *ctx = &mpc->ctx;
+    FORCESNLPsolver_float start = FORCESNLPsolver_walltime();
+    solver_int32_default warm = mpc->warm;
+    solver_int32_default exitflag;
+
+    if( warm )
+    {
+        shift(&ctx->params, &ctx->output, ctx->horizon);
+        memcpy(ctx->params.x0 + 2, xinit, 4*sizeof(FORCESNLPsolver_float));
+    }
+    else if( mpc->guess )
+    {
+        memcpy(ctx->params.x0, mpc->guess, sizeof(ctx->params.x0));
+    }
+    else
+    {
+        cold_start(&ctx->params);
+    }
+    memcpy(ctx->params.xinit, xinit, 4*sizeof(FORCESNLPsolver_float));
+
+    exitflag = FORCESNLPsolver_context_solve(ctx, mpc->fs);
+
+    /* a solve stopped at an iteration or time limit still gives a usable 
+     * guess, in real-time iteration mode this continues from the last one */
+    mpc->warm = exitflag >= FORCESNLPsolver_MAXITREACHED || exitflag == FORCESNLPsolver_DEADLINE;
+    mpc->steps++;
+
+    if( step )
+    {
+        step->exitflag = exitflag;
+        step->it = ctx->info.it;
+        step->warm = warm;
+        step->latency = FORCESNLPsolver_walltime() - start;
+        step->solvetime = ctx->info.solvetime;
+        memcpy(step->xinit, xinit, 4*sizeof(FORCESNLPsolver_float));
+        memcpy(step->u, ctx->output.x001, 2*sizeof(FORCESNLPsolver_float));
+    }
+    return exitflag;
+}
+
+/* state after one sampling period */
+extern void FORCESNLPsolver_mpc_simulate(const FORCESNLPsolver_float *x, const FORCESNLPsolver_float *u, FORCESNLPsolver_float *xnext)
+{
+    FORCESNLPsolver_float z[FORCESNLPsolver_NVAR];
+
+    z[0] = u[0];
+    z[1] = u[1];
+    memcpy(z + 2, x, 4*sizeof(FORCESNLPsolver_float));
+    dynamics(z, xnext);
+}
+
+/* closed loop simulation */
+extern solver_int32_default FORCESNLPsolver_mpc_run(FORCESNLPsolver_mpc *mpc, const FORCESNLPsolver_float *xinit, solver_int32_default nsteps, FORCESNLPsolver_mpc_stats *steps)
+{
+    FORCESNLPsolver_float x[4];
+    solver_int32_default k;
+
+    memcpy(x, xinit, 4*sizeof(FORCESNLPsolver_float));
+    for( k=0; k<nsteps; k++ )
+    {
+        if( FORCESNLPsolver_mpc_step(mpc, x, steps ? steps + k : 0) < FORCESNLPsolver_MAXITREACHED && !mpc->warm )
+        {
+            break;
+        }
+        FORCESNLPsolver_mpc_simulate(x, mpc->ctx.output.x001, x);
+    }
+    return k;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
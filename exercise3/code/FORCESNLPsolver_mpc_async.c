@@ -0,0 +1,238 @@
+/*
+ * Asynchronous receding horizon control: the steps of a controller run on
+ * a worker thread, the caller requests a step and takes the solution of
+ * the last completed one. A solve that takes longer than a sampling
+ * period then delays the solution instead of the caller, requests made
+ * while it runs are dropped.
+ *
+ * The worker waits on a condition variable between steps, so a step does
+ * neither create a thread nor allocate memory.
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+/* worker thread, lock and condition variable */
+#if defined(_WIN32)
+#include <windows.h>
+typedef struct worker
+{
+    HANDLE thread;
+    CRITICAL_SECTION lock;
+    CONDITION_VARIABLE cond;
+} worker;
+#define LOCK(w) EnterCriticalSection(&(w)->lock)
+#define UNLOCK(w) LeaveCriticalSection(&(w)->lock)
+#define WAIT(w) SleepConditionVariableCS(&(w)->cond, &(w)->lock, INFINITE)
+#define BROADCAST(w) WakeAllConditionVariable(&(w)->cond)
+#else
+#include <pthread.h>
+typedef struct worker
+{
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} worker;
+#define LOCK(w) pthread_mutex_lock(&(w)->lock)
+#define UNLOCK(w) pthread_mutex_unlock(&(w)->lock)
+#define WAIT(w) pthread_cond_wait(&(w)->cond, &(w)->lock)
+#define BROADCAST(w) pthread_cond_broadcast(&(w)->cond)
+#endif
+
+/* runs the requested steps until stopped */
+static void run(FORCESNLPsolver_mpc_async *async)
+{
+    worker *w = (worker *)async->worker;
+    FORCESNLPsolver_float xinit[4];
+    FORCESNLPsolver_mpc_stats stats;
+
+    LOCK(w);
+    for( ;; )
+    {
+        while( async->busy == 0 )
+        {
+            WAIT(w);
+        }
+        if( async->busy == 2 )
+        {
+            break;
+        }
+        memcpy(xinit, async->xinit, sizeof(xinit));
+        memcpy(async->mpc.ctx.params.xfinal, async->xfinal, sizeof(async->xfinal));
+        UNLOCK(w);
+
+        FORCESNLPsolver_mpc_step(&async->mpc, xinit, &stats);
+
+        LOCK(w);
+        memcpy(async->z, async->mpc.ctx.output.x001, sizeof(async->z));
+        async->stats = stats;
+        async->completed++;
+        async->busy = 0;
+        BROADCAST(w);
+    }
+    UNLOCK(w);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI thread_main(LPVOID async)
+{
+    run((FORCESNLPsolver_mpc_async *)async);
+    return 0;
+}
+#else
+static void *thread_main(void *async)
+{
+    run((FORCESNLPsolver_mpc_async *)async);
+    return NULL;
+}
+#endif
+
+/* prepares a controller and starts its worker */
+extern solver_int32_default FORCESNLPsolver_mpc_async_start(FORCESNLPsolver_mpc_async *async, const FORCESNLPsolver_float *xfinal, solver_int32_default horizon)
+{
+    worker *w = (worker *)malloc(sizeof(worker));
+
+    FORCESNLPsolver_mpc_init(&async->mpc, xfinal, horizon);
+    memcpy(async->xfinal, xfinal, sizeof(async->xfinal));
+    async->completed = 0;
+    async->dropped = 0;
+    async->busy = 0;
+    async->worker = w;
+    if( w == NULL )
+    {
+        return FORCESNLPsolver_NOMEMORY;
+    }
+
+#if defined(_WIN32)
+    InitializeCriticalSection(&w->lock);
+    InitializeConditionVariable(&w->cond);
+    w->thread = CreateThread(NULL, 0, thread_main, async, 0, NULL);
+    if( w->thread == NULL )
+    {
+        DeleteCriticalSection(&w->lock);
+        free(w);
+        async->worker = NULL;
+        return FORCESNLPsolver_NOMEMORY;
+    }
+#else
+    pthread_mutex_init(&w->lock, NULL);
+    pthread_cond_init(&w->cond, NULL);
+    if( pthread_create(&w->thread, NULL, thread_main, async) )
+    {
+        pthread_cond_destroy(&w->cond);
+        pthread_mutex_destroy(&w->lock);
+        free(w);
+        async->worker = NULL;
+        return FORCESNLPsolver_NOMEMORY;
+    }
+#endif
+    return 0;
+}
+
+/* requests a step and takes the last completed one */
+extern solver_int32_default FORCESNLPsolver_mpc_async_step(FORCESNLPsolver_mpc_async *async, const FORCESNLPsolver_float *xinit, const FORCESNLPsolver_float *xfinal, const FORCESNLPsolver_float *guess, FORCESNLPsolver_float *z, FORCESNLPsolver_mpc_stats *step)
+{
+    worker *w = (worker *)async->worker;
+    solver_int32_default completed;
+
+    /* not started, or its worker could not be started */
+    if( w == NULL )
+    {
+        return FORCESNLPsolver_NOMEMORY;
+    }
+    LOCK(w);
+    completed = async->completed;
+    if( completed > 0 && z )
+    {
+        memcpy(z, async->z, sizeof(async->z));
+    }
+    if( completed > 0 && step )
+    {
+        *step = async->stats;
+    }
+
+    if( async->busy == 0 )
+    {
+        memcpy(async->xinit, xinit, sizeof(async->xinit));
+        memcpy(async->xfinal, xfinal, sizeof(async->xfinal));
+
+        /* the guess is only read by steps that are not warm started */
+        async->mpc.guess = NULL;
+        if( guess && !async->mpc.warm )
+        {
+            memcpy(async->guess, guess, sizeof(async->guess));
+            async->mpc.guess = async->guess;
+        }
+        async->busy = 1;
+        BROADCAST(w);
+    }
+    else
+    {
+        async->dropped++;
+    }
+    UNLOCK(w);
+    return completed;
+}
+
+/* waits for the requested step */
+extern solver_int32_default FORCESNLPsolver_mpc_async_wait(FORCESNLPsolver_mpc_async *async)
+{
+    worker *w = (worker *)async->worker;
+
+    if( w == NULL )
+    {
+        return FORCESNLPsolver_NOMEMORY;
+    }
+    LOCK(w);
+    while( async->busy == 1 )
+    {
+        WAIT(w);
+    }
+    UNLOCK(w);
+    return 0;
+}
+
+/* stops the worker */
+extern void FORCESNLPsolver_mpc_async_stop(FORCESNLPsolver_mpc_async *async)
+{
+    worker *w = (worker *)async->worker;
+
+    if( w == NULL )
+    {
+        return;
+    }
+    LOCK(w);
+    while( async->busy == 1 )
+    {
+        WAIT(w);
+    }
+    async->busy = 2;
+    BROADCAST(w);
+    UNLOCK(w);
+
+#if defined(_WIN32)
+    WaitForSingleObject(w->thread, INFINITE);
+    CloseHandle(w->thread);
+    DeleteCriticalSection(&w->lock);
+#else
+    pthread_join(w->thread, NULL);
+    pthread_cond_destroy(&w->cond);
+    pthread_mutex_destroy(&w->lock);
+#endif
+    free(w);
+    async->worker = NULL;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
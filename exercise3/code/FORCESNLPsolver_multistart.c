@@ -0,0 +1,305 @@
+/*
+ * Multi-start solves: the feasible set (the ring 1 <= x^2 + y^2 <= 9
+ * without the disk around the obstacle at (-2, 2.5)) is not convex, and
+ * which local optimum the solver converges to depends on the initial
+ * guess. A multi-start solve runs several initial guesses, one context
+ * per start, and returns the best optimal solution.
+ *
+ * The starts race: once one of them has converged, the others are
+ * cancelled as soon as they are feasible with a worse objective, and all
+ * of them once they ran a grace time longer than it. The run time of a
+ * start is measured from the moment it holds the solver.
+ *
+ * The solver keeps its workspace in static memory unless it was generated
+ * with FORCESNLPsolver_THREADSAFE_STORAGE, so without it the starts run
+ * one after another on the calling thread. Only with it do they run
+ * concurrently, and the wall clock time of a multi-start solve on enough
+ * cores is at most a small multiple of that of its fastest start.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+/* centre of the obstacle of the inequalities, (x + 2)^2 + (y - 2.5)^2 >= 1 */
+#define OBSTACLE_X      (-2.0)
+#define OBSTACLE_Y      (2.5)
+
+/* sampling period, the RK4 step of the model */
+#define STEP            (0.1)
+
+/* distance from the obstacle centre of the points the guesses lead to, 
+ * and number of directions tried */
+#define VIA_RADIUS      (1.5)
+#define VIA_DIRECTIONS  (72)
+
+/* iterates with max(res_eq, res_ineq) below this are compared by their 
+ * objective, which must be worse by more than the relative duality gap 
+ * the solver accepts to be cancelled */
+#define FEASIBLE_TOL    (1E-03)
+
+/* state shared by the starts of one multi-start solve */
+typedef struct race
+{
+    /* objective of the best optimal start, valid if winner >= 0 */
+    FORCESNLPsolver_float pobj;
+    solver_int32_default winner;
+
+    /* solve time after which the remaining starts are cancelled, 0 for 
+     * none */
+    FORCESNLPsolver_float budget;
+
+} race;
+
+
+static FORCESNLPsolver_float clip(FORCESNLPsolver_float v, FORCESNLPsolver_float lo, FORCESNLPsolver_float hi)
+{
+    return v < lo ? lo : v > hi ? hi : v;
+}
+
+/* initial guess j of n */
+extern void FORCESNLPsolver_multistart_guess(const FORCESNLPsolver_params *params, solver_int32_default horizon, solver_int32_default j, solver_int32_default n, FORCESNLPsolver_float *x0)
+{
+    /* speed profiles: progress along the path proportional to t^speed */
+    static const FORCESNLPsolver_float speed[3] = {1.0, 0.5, 2.0};
+    const FORCESNLPsolver_float pi = 3.14159265358979323846;
+    FORCESNLPsolver_float angle[VIA_DIRECTIONS];
+    FORCESNLPsolver_float via[2], d[2], s, r;
+    FORCESNLPsolver_float *z;
+    solver_int32_default k, i, count = 0;
+
+    horizon = horizon < 2 ? 2 : horizon > FORCESNLPsolver_N ? FORCESNLPsolver_N : horizon;
+
+    /* directions from the obstacle in which the point at VIA_RADIUS lies 
+     * within the bounds and the ring */
+    for( k=0; k<VIA_DIRECTIONS; k++ )
+    {
+        s = 2*pi*k/VIA_DIRECTIONS;
+        via[0] = OBSTACLE_X + VIA_RADIUS*cos(s);
+        via[1] = OBSTACLE_Y + VIA_RADIUS*sin(s);
+        r = via[0]*via[0] + via[1]*via[1];
+        if( via[0] >= FORCESNLPsolver_lb[2] && via[0] <= FORCESNLPsolver_ub[2] && via[1] >= FORCESNLPsolver_lb[3] && via[1] <= FORCESNLPsolver_ub[3] 
+         && r >= FORCESNLPsolver_hl[0] && r <= FORCESNLPsolver_hu[0] )
+        {
+            angle[count++] = s;
+        }
+    }
+
+    /* the guesses lead to points spread over these directions, counted 
+     * from the first gap so that an arc through angle 0 stays in one piece */
+    k = 1;
+    while( k < count && angle[k] - angle[k - 1] < 1.5*2*pi/VIA_DIRECTIONS )
+    {
+        k++;
+    }
+    if( count > 0 )
+    {
+        s = angle[(k + (2*j + 1)*count/(2*(n > 0 ? n : 1))) % count];
+    }
+    else
+    {
+        s = 2*pi*(j + 0.5)/(n > 0 ? n : 1);
+    }
+    via[0] = clip(OBSTACLE_X + VIA_RADIUS*cos(s), FORCESNLPsolver_lb[2], FORCESNLPsolver_ub[2]);
+    via[1] = clip(OBSTACLE_Y + VIA_RADIUS*sin(s), FORCESNLPsolver_lb[3], FORCESNLPsolver_ub[3]);
+
+    /* positions on the straight path from xinit to the via point */
+    for( k=0; k<horizon; k++ )
+    {
+        z = x0 + k*FORCESNLPsolver_NVAR;
+        s = pow((FORCESNLPsolver_float)k/(horizon - 1), speed[j % 3]);
+        z[0] = 0;
+        z[1] = 0;
+        z[2] = params->xinit[0] + s*(via[0] - params->xinit[0]);
+        z[3] = params->xinit[1] + s*(via[1] - params->xinit[1]);
+    }
+
+    /* speed and heading towards the next position, the initial and final 
+     * conditions */
+    for( k=0; k<horizon - 1; k++ )
+    {
+        z = x0 + k*FORCESNLPsolver_NVAR;
+        d[0] = z[FORCESNLPsolver_NVAR + 2] - z[2];
+        d[1] = z[FORCESNLPsolver_NVAR + 3] - z[3];
+        z[4] = sqrt(d[0]*d[0] + d[1]*d[1])/STEP;
+        z[5] = z[4] > 0 ? atan2(d[1], d[0]) : params->xinit[3];
+    }
+    memcpy(x0 + 2, params->xinit, 4*sizeof(FORCESNLPsolver_float));
+    x0[(horizon - 1)*FORCESNLPsolver_NVAR + 4] = params->xfinal[0];
+    x0[(horizon - 1)*FORCESNLPsolver_NVAR + 5] = params->xfinal[1];
+
+    /* bounds, and stages behind the active horizon hold the last state */
+    for( k=0; k<FORCESNLPsolver_N; k++ )
+    {
+        z = x0 + k*FORCESNLPsolver_NVAR;
+        if( k >= horizon )
+        {
+            memcpy(z, z - FORCESNLPsolver_NVAR, FORCESNLPsolver_NVAR*sizeof(FORCESNLPsolver_float));
+        }
+        for( i=0; i<FORCESNLPsolver_NVAR; i++ )
+        {
+            z[i] = clip(z[i], FORCESNLPsolver_lb[i], FORCESNLPsolver_ub[i]);
+        }
+    }
+}
+
+/* cancels a start that is dominated by a converged one */
+static solver_int32_default cancel_dominated(void *data, const FORCESNLPsolver_monitor *monitor)
+{
+    race *shared = (race *)data;
+    FORCESNLPsolver_float elapsed = FORCESNLPsolver_walltime() - monitor->start;
+    FORCESNLPsolver_float res = monitor->iterate_res_eq > monitor->iterate_res_ineq ? monitor->iterate_res_eq : monitor->iterate_res_ineq;
+    solver_int32_default cancel = 0;
+
+#ifdef _OPENMP
+    #pragma omp critical (FORCESNLPsolver_multistart)
+#endif
+    {
+        if( shared->winner >= 0 )
+        {
+            cancel = (shared->budget > 0 && elapsed >= shared->budget)
+                  || (res <= FEASIBLE_TOL && monitor->iterate_pobj > shared->pobj + FORCESNLPsolver_SET_ACC_RDGAP*(1 + fabs(shared->pobj)));
+        }
+    }
+    return cancel;
+}
+
+/* true if start a is a better result than start b */
+static solver_int32_default better(const FORCESNLPsolver_context *a, solver_int32_default flag_a, const FORCESNLPsolver_context *b, solver_int32_default flag_b)
+{
+    FORCESNLPsolver_float res_a = a->info.res_eq > a->info.res_ineq ? a->info.res_eq : a->info.res_ineq;
+    FORCESNLPsolver_float res_b = b->info.res_eq > b->info.res_ineq ? b->info.res_eq : b->info.res_ineq;
+
+    if( (flag_a == FORCESNLPsolver_OPTIMAL) != (flag_b == FORCESNLPsolver_OPTIMAL) )
+    {
+        return flag_a == FORCESNLPsolver_OPTIMAL;
+    }
+    if( flag_a == FORCESNLPsolver_OPTIMAL )
+    {
+        return a->info.pobj < b->info.pobj;
+    }
+    return res_a < res_b;
+}
+
+/* solves the problem of a context from several initial guesses */
+extern solver_int32_default FORCESNLPsolver_solve_multistart(FORCESNLPsolver_context *ctx, solver_int32_default nstarts, const FORCESNLPsolver_float *x0, solver_int32_default nthreads, FORCESNLPsolver_multistart_stats *stats)
+{
+    FORCESNLPsolver_context *contexts;
+    solver_int32_default exitflag[FORCESNLPsolver_MULTISTART_MAX];
+    race shared;
+    FORCESNLPsolver_float begin = FORCESNLPsolver_walltime();
+    solver_int32_default best, j;
+
+    nstarts = nstarts < 1 ? 1 : nstarts > FORCESNLPsolver_MULTISTART_MAX ? FORCESNLPsolver_MULTISTART_MAX : nstarts;
+#if defined(_OPENMP) && FORCESNLPsolver_THREADSAFE_STORAGE
+    nthreads = nthreads > 0 ? nthreads : omp_get_max_threads();
+#else
+    /* the solves would only queue up behind the solver lock */
+    nthreads = 1;
+#endif
+    nthreads = nthreads < nstarts ? nthreads : nstarts;
+
+    contexts = (FORCESNLPsolver_context *)malloc(nstarts*sizeof(FORCESNLPsolver_context));
+    if( contexts == NULL )
+    {
+        return FORCESNLPsolver_NOMEMORY;
+    }
+
+    shared.pobj = 0;
+    shared.winner = -1;
+    shared.budget = 0;
+
+    /* start 0 is the initial guess of the context */
+    for( j=0; j<nstarts; j++ )
+    {
+        FORCESNLPsolver_context_init(contexts + j);
+        FORCESNLPsolver_context_set_horizon(contexts + j, ctx->horizon);
+        FORCESNLPsolver_context_set_limits(contexts + j, ctx->timelimit, ctx->rti);
+        contexts[j].params = ctx->params;
+        contexts[j].cancel = &cancel_dominated;
+        contexts[j].cancel_data = &shared;
+        if( x0 )
+        {
+            memcpy(contexts[j].params.x0, x0 + j*FORCESNLPsolver_N*FORCESNLPsolver_NVAR, sizeof(contexts[j].params.x0));
+        }
+        else if( j > 0 )
+        {
+            FORCESNLPsolver_multistart_guess(&ctx->params, ctx->horizon, j - 1, nstarts - 1, contexts[j].params.x0);
+        }
+    }
+
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1)
+#endif
+    for( j=0; j<nstarts; j++ )
+    {
+        FORCESNLPsolver_float elapsed;
+
+        /* the monitor starts the clock once the solver is held */
+        exitflag[j] = FORCESNLPsolver_context_solve(contexts + j, NULL);
+        elapsed = FORCESNLPsolver_walltime() - contexts[j].monitor.start;
+
+        if( exitflag[j] == FORCESNLPsolver_OPTIMAL )
+        {
+#ifdef _OPENMP
+            #pragma omp critical (FORCESNLPsolver_multistart)
+#endif
+            {
+                if( shared.winner < 0 || contexts[j].info.pobj < shared.pobj )
+                {
+                    shared.pobj = contexts[j].info.pobj;
+                    shared.winner = j;
+                }
+                if( shared.budget <= 0 && FORCESNLPsolver_MULTISTART_GRACE > 0 )
+                {
+                    shared.budget = (1 + FORCESNLPsolver_MULTISTART_GRACE)*elapsed;
+                }
+            }
+        }
+    }
+
+    best = 0;
+    for( j=1; j<nstarts; j++ )
+    {
+        if( better(contexts + j, exitflag[j], contexts + best, exitflag[best]) )
+        {
+            best = j;
+        }
+    }
+    ctx->output = contexts[best].output;
+    ctx->info = contexts[best].info;
+
+    if( stats )
+    {
+        stats->nstarts = nstarts;
+        stats->best = best;
+        stats->noptimal = 0;
+        stats->ncancelled = 0;
+        for( j=0; j<nstarts; j++ )
+        {
+            stats->exitflag[j] = exitflag[j];
+            stats->it[j] = contexts[j].info.it;
+            stats->pobj[j] = contexts[j].info.pobj;
+            stats->noptimal += exitflag[j] == FORCESNLPsolver_OPTIMAL;
+            stats->ncancelled += exitflag[j] == FORCESNLPsolver_CANCELLED;
+        }
+        stats->nthreads = nthreads;
+        stats->walltime = FORCESNLPsolver_walltime() - begin;
+    }
+
+    free(contexts);
+    return exitflag[best];
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
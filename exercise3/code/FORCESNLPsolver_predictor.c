@@ -0,0 +1,411 @@
+/*
+ * Tangential predictor: first order update of a converged solution for a
+ * changed initial state xinit, without a new solve.
+ *
+ * The solver neither exposes its KKT factorization nor the multipliers of
+ * its solution, so the predictor linearizes the problem itself at the
+ * solution z*: the dynamics with their Jacobians A_k, B_k, the final
+ * condition and every constraint active at z* (variable bounds and h
+ * within FORCESNLPsolver_PREDICTOR_TOL) are held as linear equalities, and
+ * the input changes du minimize the quadratic input costs du'*R*du of the
+ * objective. The states are eliminated through the dynamics, so that all
+ * constraints become rows G du = -Phi dxinit on the inputs of the active
+ * horizon, and
+ *
+ *     du = -R^-1 G' (G R^-1 G')^-1 Phi dxinit.
+ *
+ * _update factors G R^-1 G' once and stores dz/dxinit, _predict is then a
+ * single product of that 600 x 4 matrix with dxinit. Without multipliers
+ * the curvature of the constraints is not part of the prediction, it is
+ * exact for the constraints to first order and optimal for problems whose
+ * objective curvature is in the inputs only.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+/* stage model with Jacobians, in double precision */
+#ifdef FORCESNLPsolver_SINGLE_PRECISION_MODELS
+extern void FORCESNLPsolver_model_1_double(const FORCESNLPsolver_float **arg, FORCESNLPsolver_float **res);
+#define model_1 FORCESNLPsolver_model_1_double
+#else
+extern void FORCESNLPsolver_model_1(const FORCESNLPsolver_float **arg, FORCESNLPsolver_float **res);
+#define model_1 FORCESNLPsolver_model_1
+#endif
+
+/* dense column major position of the nonzeros of the dynamics Jacobian */
+static const solver_int32_default nabla_c_dense[16] = {0, 1, 2, 3, 4, 5, 7, 8, 13, 16, 17, 18, 19, 20, 21, 23};
+
+/* constraint rows held by the predictor */
+typedef struct rows
+{
+    solver_int32_default m;
+    solver_int32_default nu;
+    FORCESNLPsolver_float *G;     /* m x nu, row major */
+    FORCESNLPsolver_float *Phi;   /* m x 4, row major */
+} rows;
+
+/* adds the row r'*dx_k = 0 on the states of stage k, expressed in the
+ * inputs of stages 0..k-1 and dxinit by an adjoint sweep */
+static void add_state_row(rows *g, const FORCESNLPsolver_float *AB, const FORCESNLPsolver_float *r, solver_int32_default k)
+{
+    FORCESNLPsolver_float *G = g->G + g->m*g->nu;
+    FORCESNLPsolver_float w[4], v[4];
+    const FORCESNLPsolver_float *J;
+    solver_int32_default i, j, n;
+
+    memset(G, 0, g->nu*sizeof(FORCESNLPsolver_float));
+    memcpy(w, r, sizeof(w));
+    for( n=k - 1; n>=0; n-- )
+    {
+        /* Jacobian of stage n, 4 x 6 column major: B in columns 0-1, A in 2-5 */
+        J = AB + n*FORCESNLPsolver_NEQ*FORCESNLPsolver_NVAR;
+        for( j=0; j<2; j++ )
+        {
+            for( i=0; i<4; i++ )
+            {
+                G[2*n + j] += J[4*j + i]*w[i];
+            }
+        }
+        for( j=0; j<4; j++ )
+        {
+            v[j] = 0;
+            for( i=0; i<4; i++ )
+            {
+                v[j] += J[4*(2 + j) + i]*w[i];
+            }
+        }
+        memcpy(w, v, sizeof(w));
+    }
+    memcpy(g->Phi + 4*g->m, w, sizeof(w));
+    g->m++;
+}
+
+/* adds the row du_k(i) = 0 */
+static void add_input_row(rows *g, solver_int32_default k, solver_int32_default i)
+{
+    memset(g->G + g->m*g->nu, 0, g->nu*sizeof(FORCESNLPsolver_float));
+    memset(g->Phi + 4*g->m, 0, 4*sizeof(FORCESNLPsolver_float));
+    g->G[g->m*g->nu + 2*k + i] = 1.;
+    g->m++;
+}
+
+/* in-place Cholesky factorization of the m x m matrix M. Rows that depend
+ * on earlier ones are dropped by zeroing their column of L. Returns the
+ * number of dropped rows. */
+static solver_int32_default cholesky(FORCESNLPsolver_float *M, solver_int32_default m)
+{
+    FORCESNLPsolver_float d, dmax = 0;
+    solver_int32_default i, j, k, dropped = 0;
+
+    for( i=0; i<m; i++ )
+    {
+        dmax = M[i*m + i] > dmax ? M[i*m + i] : dmax;
+    }
+    for( j=0; j<m; j++ )
+    {
+        d = M[j*m + j];
+        for( k=0; k<j; k++ )
+        {
+            d -= M[j*m + k]*M[j*m + k];
+        }
+        if( d <= 1e-12*dmax )
+        {
+            for( i=j; i<m; i++ )
+            {
+                M[i*m + j] = 0;
+            }
+            dropped++;
+            continue;
+        }
+        d = sqrt(d);
+        M[j*m + j] = d;
+        for( i=j + 1; i<m; i++ )
+        {
+            for( k=0; k<j; k++ )
+            {
+                M[i*m + j] -= M[i*m + k]*M[j*m + k];
+            }
+            M[i*m + j] /= d;
+        }
+    }
+    return dropped;
+}
+
+/* solves L L' x = b with the factor of cholesky, dropped rows give 0 */
+static void cholesky_solve(const FORCESNLPsolver_float *L, solver_int32_default m, FORCESNLPsolver_float *b)
+{
+    solver_int32_default i, k;
+
+    for( i=0; i<m; i++ )
+    {
+        for( k=0; k<i; k++ )
+        {
+            b[i] -= L[i*m + k]*b[k];
+        }
+        b[i] = L[i*m + i] > 0 ? b[i]/L[i*m + i] : 0;
+    }
+    for( i=m - 1; i>=0; i-- )
+    {
+        for( k=i + 1; k<m; k++ )
+        {
+            b[i] -= L[k*m + i]*b[k];
+        }
+        b[i] = L[i*m + i] > 0 ? b[i]/L[i*m + i] : 0;
+    }
+}
+
+/* 1 if z is within the tolerance of a bound */
+static solver_int32_default at_bound(FORCESNLPsolver_float z, FORCESNLPsolver_float lower, FORCESNLPsolver_float upper)
+{
+    return fabs(z - lower) < FORCESNLPsolver_PREDICTOR_TOL || fabs(upper - z) < FORCESNLPsolver_PREDICTOR_TOL;
+}
+
+/* linearizes and factors the problem at the solution of a context */
+extern solver_int32_default FORCESNLPsolver_predictor_update(FORCESNLPsolver_predictor *pred, const FORCESNLPsolver_context *ctx)
+{
+    const FORCESNLPsolver_float *z = ctx->output.x001;
+    solver_int32_default H = ctx->horizon;
+    solver_int32_default nu = 2*(H - 1);
+    const FORCESNLPsolver_float *in[4];
+    FORCESNLPsolver_float *out[6];
+    FORCESNLPsolver_float c[FORCESNLPsolver_NEQ], nabla_h[4], sparse[16], r[4];
+    FORCESNLPsolver_float *AB, *M, *N, *du;
+    FORCESNLPsolver_float dx[4], dxn[4];
+    const FORCESNLPsolver_float *J;
+    rows g;
+    solver_int32_default k, i, j, col, mmax;
+
+    /* input weights of the objective, diag(R) = 2*[b1 b2] */
+    FORCESNLPsolver_float input_weight[2];
+    input_weight[0] = 2.*ctx->weights[1];
+    input_weight[1] = 2.*ctx->weights[2];
+
+    pred->valid = 0;
+    pred->horizon = H;
+    memcpy(pred->z, z, sizeof(pred->z));
+    memcpy(pred->xinit, ctx->params.xinit, sizeof(pred->xinit));
+
+    /* constraint rows: final condition, inputs and states at a bound,
+     * active inequalities. Stage 0 is fixed by xinit. */
+    mmax = 2 + 8*(H - 1);
+    AB = (FORCESNLPsolver_float *)calloc((H > 1 ? H - 1 : 1)*FORCESNLPsolver_NEQ*FORCESNLPsolver_NVAR, sizeof(FORCESNLPsolver_float));
+    g.G = (FORCESNLPsolver_float *)malloc(mmax*(nu > 0 ? nu : 1)*sizeof(FORCESNLPsolver_float));
+    g.Phi = (FORCESNLPsolver_float *)malloc(mmax*4*sizeof(FORCESNLPsolver_float));
+    g.m = 0;
+    g.nu = nu;
+    if( AB == NULL || g.G == NULL || g.Phi == NULL )
+    {
+        free(AB);
+        free(g.G);
+        free(g.Phi);
+        return FORCESNLPsolver_NOMEMORY;
+    }
+
+    /* stage model at the solution */
+    in[1] = 0;
+    in[2] = 0;
+    in[3] = 0;
+    out[0] = 0;
+    out[1] = 0;
+    out[3] = nabla_h;
+    out[4] = c;
+    for( k=0; k<FORCESNLPsolver_N; k++ )
+    {
+        in[0] = z + k*FORCESNLPsolver_NVAR;
+        out[2] = pred->h + k*FORCESNLPsolver_NH;
+        out[5] = k < H - 1 ? sparse : 0;
+        model_1(in, out);
+
+        /* gradients of h in x and y */
+        pred->dh[4*k] = nabla_h[0];
+        pred->dh[4*k + 1] = nabla_h[2];
+        pred->dh[4*k + 2] = nabla_h[1];
+        pred->dh[4*k + 3] = nabla_h[3];
+
+        if( k < H - 1 )
+        {
+            for( i=0; i<16; i++ )
+            {
+                AB[k*FORCESNLPsolver_NEQ*FORCESNLPsolver_NVAR + nabla_c_dense[i]] = sparse[i];
+            }
+        }
+    }
+
+    for( k=0; k<H; k++ )
+    {
+        for( i=0; k<H - 1 && i<2; i++ )
+        {
+            if( at_bound(z[k*FORCESNLPsolver_NVAR + i], FORCESNLPsolver_lb[i], FORCESNLPsolver_ub[i]) )
+            {
+                add_input_row(&g, k, i);
+            }
+        }
+        for( i=0; k>0 && i<4; i++ )
+        {
+            /* v and theta of the last stage are fixed by the final condition */
+            if( k == H - 1 && i >= 2 )
+            {
+                memset(r, 0, sizeof(r));
+                r[i] = 1.;
+                add_state_row(&g, AB, r, k);
+            }
+            else if( at_bound(z[k*FORCESNLPsolver_NVAR + 2 + i], FORCESNLPsolver_lb[2 + i], FORCESNLPsolver_ub[2 + i]) )
+            {
+                memset(r, 0, sizeof(r));
+                r[i] = 1.;
+                add_state_row(&g, AB, r, k);
+            }
+        }
+        for( j=0; k>0 && j<FORCESNLPsolver_NH; j++ )
+        {
+            if( at_bound(pred->h[k*FORCESNLPsolver_NH + j], FORCESNLPsolver_hl[j], FORCESNLPsolver_hu[j]) )
+            {
+                r[0] = pred->dh[4*k + 2*j];
+                r[1] = pred->dh[4*k + 2*j + 1];
+                r[2] = 0;
+                r[3] = 0;
+                add_state_row(&g, AB, r, k);
+            }
+        }
+    }
+    pred->nactive = g.m;
+
+    /* multipliers of the rows: (G R^-1 G') N = -Phi */
+    M = (FORCESNLPsolver_float *)calloc(g.m > 0 ? g.m*g.m : 1, sizeof(FORCESNLPsolver_float));
+    N = (FORCESNLPsolver_float *)malloc((g.m > 0 ? g.m : 1)*4*sizeof(FORCESNLPsolver_float));
+    du = (FORCESNLPsolver_float *)calloc((nu > 0 ? nu : 1)*4, sizeof(FORCESNLPsolver_float));
+    if( M == NULL || N == NULL || du == NULL )
+    {
+        free(AB);
+        free(g.G);
+        free(g.Phi);
+        free(M);
+        free(N);
+        free(du);
+        return FORCESNLPsolver_NOMEMORY;
+    }
+    for( i=0; i<g.m; i++ )
+    {
+        for( j=0; j<=i; j++ )
+        {
+            for( k=0; k<nu; k++ )
+            {
+                M[i*g.m + j] += g.G[i*nu + k]*g.G[j*nu + k]/input_weight[k % 2];
+            }
+        }
+    }
+    pred->ndropped = cholesky(M, g.m);
+    for( col=0; col<4; col++ )
+    {
+        for( i=0; i<g.m; i++ )
+        {
+            N[i] = -g.Phi[4*i + col];
+        }
+        cholesky_solve(M, g.m, N);
+
+        /* du = R^-1 G' N */
+        for( i=0; i<g.m; i++ )
+        {
+            for( k=0; k<nu; k++ )
+            {
+                du[4*k + col] += g.G[i*nu + k]*N[i]/input_weight[k % 2];
+            }
+        }
+    }
+
+    /* dz/dxinit by the linear dynamics, one column per component of xinit.
+     * Inputs of the last stage and of stages behind the active horizon
+     * do not change, their states hold the last one. */
+    for( col=0; col<4; col++ )
+    {
+        memset(dx, 0, sizeof(dx));
+        dx[col] = 1.;
+        for( k=0; k<FORCESNLPsolver_N; k++ )
+        {
+            FORCESNLPsolver_float *dzk = pred->dz + 4*k*FORCESNLPsolver_NVAR;
+
+            dzk[col] = k < H - 1 ? du[4*2*k + col] : 0;
+            dzk[4 + col] = k < H - 1 ? du[4*(2*k + 1) + col] : 0;
+            for( i=0; i<4; i++ )
+            {
+                dzk[4*(2 + i) + col] = dx[i];
+            }
+            if( k < H - 1 )
+            {
+                J = AB + k*FORCESNLPsolver_NEQ*FORCESNLPsolver_NVAR;
+                for( i=0; i<4; i++ )
+                {
+                    dxn[i] = J[i]*dzk[col] + J[4 + i]*dzk[4 + col];
+                    for( j=0; j<4; j++ )
+                    {
+                        dxn[i] += J[4*(2 + j) + i]*dx[j];
+                    }
+                }
+                memcpy(dx, dxn, sizeof(dx));
+            }
+        }
+    }
+
+    free(AB);
+    free(g.G);
+    free(g.Phi);
+    free(M);
+    free(N);
+    free(du);
+    pred->valid = 1;
+    return 0;
+}
+
+/* first order update of the solution for a new xinit */
+extern solver_int32_default FORCESNLPsolver_predictor_predict(const FORCESNLPsolver_predictor *pred, const FORCESNLPsolver_float *xinit, FORCESNLPsolver_output *output)
+{
+    FORCESNLPsolver_float *z = output->x001;
+    FORCESNLPsolver_float d[4], hk;
+    const FORCESNLPsolver_float *dz;
+    solver_int32_default changed = 0;
+    solver_int32_default k, i, j;
+
+    if( !pred->valid )
+    {
+        return 1;
+    }
+    for( i=0; i<4; i++ )
+    {
+        d[i] = xinit[i] - pred->xinit[i];
+    }
+
+    for( k=0; k<FORCESNLPsolver_N; k++ )
+    {
+        for( i=0; i<FORCESNLPsolver_NVAR; i++ )
+        {
+            dz = pred->dz + 4*(k*FORCESNLPsolver_NVAR + i);
+            z[k*FORCESNLPsolver_NVAR + i] = pred->z[k*FORCESNLPsolver_NVAR + i] + dz[0]*d[0] + dz[1]*d[1] + dz[2]*d[2] + dz[3]*d[3];
+
+            /* a violated bound means the active set changes */
+            changed |= z[k*FORCESNLPsolver_NVAR + i] < FORCESNLPsolver_lb[i] - FORCESNLPsolver_PREDICTOR_TOL
+                    || z[k*FORCESNLPsolver_NVAR + i] > FORCESNLPsolver_ub[i] + FORCESNLPsolver_PREDICTOR_TOL;
+        }
+
+        /* same for the inequalities, linearized */
+        for( j=0; j<FORCESNLPsolver_NH; j++ )
+        {
+            hk = pred->h[k*FORCESNLPsolver_NH + j]
+               + pred->dh[4*k + 2*j]*(z[k*FORCESNLPsolver_NVAR + 2] - pred->z[k*FORCESNLPsolver_NVAR + 2])
+               + pred->dh[4*k + 2*j + 1]*(z[k*FORCESNLPsolver_NVAR + 3] - pred->z[k*FORCESNLPsolver_NVAR + 3]);
+            changed |= hk < FORCESNLPsolver_hl[j] - FORCESNLPsolver_PREDICTOR_TOL || hk > FORCESNLPsolver_hu[j] + FORCESNLPsolver_PREDICTOR_TOL;
+        }
+    }
+    return changed;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
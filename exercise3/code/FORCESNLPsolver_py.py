@@ -156,6 +156,10 @@ a Python wrapper for a fast solver generated by FORCES Pro v1.6.121
        INFO.solvetime - Time needed for solve (wall clock time)
        INFO.fevalstime - Time needed for function evaluations (wall clock time)
 
+   Z, EXITFLAG, INFO = FORCESNLPsolver_py.FORCESNLPsolver_solve_stacked(X0, XINIT, XFINAL, OUT)
+   solves one problem or a stack of B problems from NumPy arrays without 
+   building dictionaries, see FORCESNLPsolver_solve_stacked.
+
  See also COPYING
 
 '''
@@ -167,12 +171,22 @@ import numpy.ctypeslib as npct
 import sys
 
 #_lib = ctypes.CDLL(os.path.join(os.getcwd(),'FORCESNLPsolver/lib/FORCESNLPsolver.dll')) 
-try:
-	_lib = ctypes.CDLL(os.path.join(os.path.dirname(os.path.abspath(__file__)),'FORCESNLPsolver/lib/FORCESNLPsolver_withModel.dll'))
-	csolver = getattr(_lib,'FORCESNLPsolver_solve')
-except:
-	_lib = ctypes.CDLL(os.path.join(os.path.dirname(os.path.abspath(__file__)),'FORCESNLPsolver/lib/libFORCESNLPsolver_withModel.dll'))
-	csolver = getattr(_lib,'FORCESNLPsolver_solve')
+# the library written by FORCESNLPsolver_build.py comes first, then the 
+# one generated by FORCES Pro with the model compiled in. The shipped 
+# FORCESNLPsolver.dll has no model, it is skipped until it is rebuilt.
+_libdir = os.path.join(os.path.dirname(os.path.abspath(__file__)),'FORCESNLPsolver','lib')
+_lib = None
+for _libname in ['FORCESNLPsolver.dll','libFORCESNLPsolver.so','FORCESNLPsolver_withModel.dll','libFORCESNLPsolver_withModel.dll']:
+	try:
+		_candidate = ctypes.CDLL(os.path.join(_libdir,_libname))
+		csolver = getattr(_candidate,'FORCESNLPsolver_solve')
+		getattr(_candidate,'FORCESNLPsolver_casadi2forces')
+	except (OSError, AttributeError):
+		continue
+	_lib = _candidate
+	break
+if _lib is None:
+	raise ImportError('No solver library with the model found in ' + _libdir + '. Please build it with FORCESNLPsolver_build.py.')
 
 class FORCESNLPsolver_params_ctypes(ctypes.Structure):
 #	@classmethod
@@ -437,6 +451,37 @@ if sys.version_info.major == 2:
 csolver.argtypes = ( ctypes.POINTER(FORCESNLPsolver_params_ctypes), ctypes.POINTER(FORCESNLPsolver_outputs_ctypes), ctypes.POINTER(FORCESNLPsolver_info), ctypes.POINTER(FILE))
 csolver.restype = ctypes.c_int
 
+class FORCESNLPsolver_batch_stats(ctypes.Structure):
+	_fields_ = [('nsolves', ctypes.c_int),
+('noptimal', ctypes.c_int),
+('nthreads', ctypes.c_int),
+('walltime', ctypes.c_double),
+('solvetime', ctypes.c_double),
+('solves_per_second', ctypes.c_double)
+]
+
+# stacked solves read and write the NumPy arrays in place; ctypes releases 
+# the GIL for the duration of the call. The library generated by FORCES 
+# Pro only provides FORCESNLPsolver_solve, the one written by 
+# FORCESNLPsolver_build.py also the batch solves.
+_N = 100
+_NVAR = 6
+_info_dtype = np.dtype(FORCESNLPsolver_info)
+try:
+	cstacked = getattr(_lib,'FORCESNLPsolver_solve_stacked')
+	cstacked.argtypes = ( ctypes.c_int,
+		npct.ndpointer(np.float64, flags='C_CONTIGUOUS'),
+		npct.ndpointer(np.float64, flags='C_CONTIGUOUS'),
+		npct.ndpointer(np.float64, flags='C_CONTIGUOUS'),
+		npct.ndpointer(np.float64, flags=('C_CONTIGUOUS','WRITEABLE')),
+		npct.ndpointer(np.intc, flags=('C_CONTIGUOUS','WRITEABLE')),
+		npct.ndpointer(_info_dtype, flags=('C_CONTIGUOUS','WRITEABLE')),
+		ctypes.c_int,
+		ctypes.POINTER(FORCESNLPsolver_batch_stats))
+	cstacked.restype = ctypes.c_int
+except AttributeError:
+	cstacked = None
+
 def FORCESNLPsolver_solve(params_arg):
 	'''
 a Python wrapper for a fast solver generated by FORCES Pro v1.6.121
@@ -640,3 +685,70 @@ a Python wrapper for a fast solver generated by FORCES Pro v1.6.121
 solve = FORCESNLPsolver_solve
 
 
+def _stacked_param(name, value, size):
+	# one problem as a flat or column vector, or problems stacked along the first axis
+	value = np.ascontiguousarray(value, dtype=np.float64)
+	stacked = value.ndim == 3 or (value.ndim == 2 and value.shape[1] == size)
+	if stacked and value.size == value.shape[0]*size:
+		return value.reshape(value.shape[0], size)
+	if not stacked and value.size == size:
+		return value.reshape(size)
+	raise ValueError('Parameter ' + name + ' must hold ' + str(size) + ' values per problem, stacked along the first axis.')
+
+def FORCESNLPsolver_solve_stacked(x0, xinit, xfinal, out=None, nthreads=0, stats=None):
+	'''
+   Z, EXITFLAG, INFO = FORCESNLPsolver_solve_stacked(X0, XINIT, XFINAL, OUT) solves 
+   the problem for NumPy arrays, without dictionaries and without copying 
+   arrays that are already float64 and C-contiguous:
+       X0     - initial guess, 600 values or an array of shape (N, 6)
+       XINIT  - initial state, 4 values
+       XFINAL - final state, 2 values
+       OUT    - optional preallocated float64 C-contiguous array of shape 
+                (N, 6) that receives the solution, one stage per row
+
+   A stack of B problems is solved by passing X0 of shape (B, N, 6) or 
+   (B, 600), XINIT of shape (B, 4), XFINAL of shape (B, 2) and OUT of shape 
+   (B, N, 6); parameters given for one problem are shared by all. The 
+   problems are solved one after another unless the solver is built with 
+   FORCESNLPsolver_THREADSAFE_STORAGE=1, then they are distributed over 
+   NTHREADS threads (0 uses all cores, OpenMP builds only). The GIL is 
+   released during the solve, so other Python threads keep running.
+
+   Z is OUT (or a new array), EXITFLAG the exit flag, or an int array of 
+   length B, and INFO a record, or a record array of length B, with the 
+   fields of INFO above. A FORCESNLPsolver_batch_stats passed as STATS 
+   receives the throughput of the call.
+	'''
+	if cstacked is None:
+		raise RuntimeError('The solver library does not provide FORCESNLPsolver_solve_stacked. Please build it with FORCESNLPsolver_build.py.')
+
+	x0 = _stacked_param('x0', x0, _N*_NVAR)
+	xinit = _stacked_param('xinit', xinit, 4)
+	xfinal = _stacked_param('xfinal', xfinal, 2)
+	sizes = set(p.shape[0] for p in (x0, xinit, xfinal) if p.ndim == 2)
+	if len(sizes) > 1:
+		raise ValueError('Parameters x0, xinit and xfinal are stacked for different numbers of problems.')
+	batch = len(sizes) == 1
+	nbatch = sizes.pop() if batch else 1
+
+	# parameters shared by all problems are repeated, the only copy made
+	if batch:
+		x0 = x0 if x0.ndim == 2 else np.tile(x0, (nbatch, 1))
+		xinit = xinit if xinit.ndim == 2 else np.tile(xinit, (nbatch, 1))
+		xfinal = xfinal if xfinal.ndim == 2 else np.tile(xfinal, (nbatch, 1))
+
+	shape = (nbatch, _N, _NVAR) if batch else (_N, _NVAR)
+	if out is None:
+		out = np.empty(shape)
+	elif not isinstance(out, np.ndarray) or out.shape != shape or out.dtype != np.float64 or not out.flags['C_CONTIGUOUS'] or not out.flags['WRITEABLE']:
+		raise ValueError('Output must be a writeable float64 C-contiguous array of shape ' + str(shape) + '.')
+
+	exitflag = np.empty(nbatch, dtype=np.intc)
+	info = np.empty(nbatch, dtype=_info_dtype)
+	cstacked(nbatch, x0, xinit, xfinal, out, exitflag, info, nthreads, ctypes.byref(stats) if stats is not None else None)
+
+	if batch:
+		return out, exitflag, info.view(np.recarray)
+	return out, int(exitflag[0]), info.view(np.recarray)[0]
+
+solve_stacked = FORCESNLPsolver_solve_stacked
@@ -0,0 +1,84 @@
+/*
+ * Weight sweep: the solutions for neighbouring objective weights are close
+ * to each other, so walking a grid of weights in an order in which
+ * consecutive points are neighbours and starting every solve from the
+ * previous solution replaces a cold solve per point by a few iterations.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <string.h>
+
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+/* grid point n of the serpentine walk through the grid, the walk reverses 
+ * its direction in a after every row and in the rows after every plane */
+static void serpentine(solver_int32_default n, solver_int32_default na, solver_int32_default nb1, solver_int32_default *i)
+{
+    solver_int32_default plane = na*nb1;
+    solver_int32_default r = n % plane;
+
+    i[2] = n / plane;
+    r = i[2] % 2 ? plane - 1 - r : r;
+    i[1] = r / na;
+    i[0] = i[1] % 2 ? na - 1 - r % na : r % na;
+}
+
+/* solves on a grid of objective weights */
+extern solver_int32_default FORCESNLPsolver_sweep_weights(FORCESNLPsolver_context *ctx, const FORCESNLPsolver_float *a, solver_int32_default na, const FORCESNLPsolver_float *b1, solver_int32_default nb1, const FORCESNLPsolver_float *b2, solver_int32_default nb2, FILE *out, FORCESNLPsolver_sweep_stats *stats)
+{
+    FORCESNLPsolver_float start = FORCESNLPsolver_walltime();
+    FORCESNLPsolver_float cold[FORCESNLPsolver_N*FORCESNLPsolver_NVAR];
+    FORCESNLPsolver_float weights[3];
+    const FORCESNLPsolver_float *z;
+    solver_int32_default npoints = na > 0 && nb1 > 0 && nb2 > 0 ? na*nb1*nb2 : 0;
+    solver_int32_default noptimal = 0, nwarm = 0, it = 0, warm = 0;
+    solver_int32_default exitflag, n, k, i[3];
+
+    memcpy(cold, ctx->params.x0, sizeof(cold));
+    memcpy(weights, ctx->weights, sizeof(weights));
+
+    for( n=0; n<npoints; n++ )
+    {
+        serpentine(n, na, nb1, i);
+        FORCESNLPsolver_context_set_weights(ctx, a[i[0]], b1[i[1]], b2[i[2]]);
+
+        /* start from the previous solution, or over if there is none */
+        memcpy(ctx->params.x0, warm ? ctx->output.x001 : cold, sizeof(cold));
+        nwarm += warm;
+
+        exitflag = FORCESNLPsolver_context_solve(ctx, NULL);
+        noptimal += exitflag == FORCESNLPsolver_OPTIMAL;
+        it += ctx->info.it;
+        warm = exitflag == FORCESNLPsolver_OPTIMAL || exitflag == FORCESNLPsolver_MAXITREACHED;
+
+        if( out )
+        {
+            fprintf(out, "%.17g %.17g %.17g %d %d %.17g %.17g", a[i[0]], b1[i[1]], b2[i[2]], exitflag, ctx->info.it, ctx->info.solvetime, ctx->info.pobj);
+            z = ctx->output.x001;
+            for( k=0; k<ctx->horizon*FORCESNLPsolver_NVAR; k++ )
+            {
+                fprintf(out, " %.17g", z[k]);
+            }
+            fprintf(out, "\n");
+        }
+    }
+
+    FORCESNLPsolver_context_set_weights(ctx, weights[0], weights[1], weights[2]);
+
+    if( stats )
+    {
+        stats->npoints = npoints;
+        stats->noptimal = noptimal;
+        stats->nwarm = nwarm;
+        stats->it = it;
+        stats->walltime = FORCESNLPsolver_walltime() - start;
+    }
+    return noptimal;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
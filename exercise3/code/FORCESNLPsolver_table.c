@@ -0,0 +1,378 @@
+/*
+ * Explicit MPC: the solutions of the problem on a regular grid of initial
+ * states xinit = [x y v theta], for one final condition, computed offline
+ * with the batch solver and interpolated multilinearly at run time.
+ *
+ * A lookup reads the 16 grid points around xinit and costs the same for
+ * every xinit. It reports when the online solver has to be used instead:
+ * outside the grid, next to grid points without a solution, and where the
+ * solutions around xinit disagree (e.g. pass the obstacle on different
+ * sides), since interpolating them is meaningless.
+ *
+ * Tables store the first inputs and, optionally, the complete solutions
+ * as initial guess for the fallback solve, in single precision.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+/* problems per batch solve while building a table */
+#define BUILD_CHUNK     (256)
+
+/* file header, followed by the status, input and solution arrays */
+typedef struct file_header
+{
+    char magic[8];
+    solver_int32_default n[4];
+    solver_int32_default nx;
+    solver_int32_default reserved;
+    FORCESNLPsolver_float lo[4];
+    FORCESNLPsolver_float hi[4];
+    FORCESNLPsolver_float xfinal[2];
+    FORCESNLPsolver_float spread;
+} file_header;
+
+static const char file_magic[8] = "FNLPTB1";
+
+/* stage model, for the inequalities */
+#ifdef FORCESNLPsolver_SINGLE_PRECISION_MODELS
+extern void FORCESNLPsolver_model_1_double_val(const FORCESNLPsolver_float **arg, FORCESNLPsolver_float **res);
+#define model_1_val FORCESNLPsolver_model_1_double_val
+#else
+extern void FORCESNLPsolver_model_1_val(const FORCESNLPsolver_float **arg, FORCESNLPsolver_float **res);
+#define model_1_val FORCESNLPsolver_model_1_val
+#endif
+
+/* 1 if z satisfies the inequalities h */
+static solver_int32_default inequalities_hold(const FORCESNLPsolver_float *z)
+{
+    const FORCESNLPsolver_float *in[4];
+    FORCESNLPsolver_float *out[6];
+    FORCESNLPsolver_float h[FORCESNLPsolver_NH];
+    solver_int32_default j;
+
+    in[0] = z;
+    in[1] = 0;
+    in[2] = 0;
+    in[3] = 0;
+    out[0] = 0;
+    out[1] = 0;
+    out[2] = h;
+    out[3] = 0;
+    out[4] = 0;
+    out[5] = 0;
+    model_1_val(in, out);
+    for( j=0; j<FORCESNLPsolver_NH; j++ )
+    {
+        if( h[j] < FORCESNLPsolver_hl[j] - FORCESNLPsolver_SET_ACC_RESINEQ || h[j] > FORCESNLPsolver_hu[j] + FORCESNLPsolver_SET_ACC_RESINEQ )
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* initial state of grid point p */
+static void grid_point(const FORCESNLPsolver_table *table, solver_int32_default p, FORCESNLPsolver_float *xinit)
+{
+    solver_int32_default i;
+
+    for( i=0; i<4; i++ )
+    {
+        xinit[i] = table->lo[i] + (p % table->n[i])*(table->hi[i] - table->lo[i])/(table->n[i] - 1);
+        p /= table->n[i];
+    }
+}
+
+static solver_int32_default allocate(FORCESNLPsolver_table *table, solver_int32_default trajectories)
+{
+    table->npoints = table->n[0]*table->n[1]*table->n[2]*table->n[3];
+    table->status = (solver_int8_unsigned *)calloc(table->npoints, 1);
+    table->u = (float *)calloc(2*table->npoints, sizeof(float));
+    table->x = trajectories ? (float *)calloc(table->npoints*FORCESNLPsolver_N*FORCESNLPsolver_NVAR, sizeof(float)) : NULL;
+    if( table->status == NULL || table->u == NULL || (trajectories && table->x == NULL) )
+    {
+        FORCESNLPsolver_table_free(table);
+        return FORCESNLPsolver_NOMEMORY;
+    }
+    return 0;
+}
+
+/* solves the problem on a grid */
+extern solver_int32_default FORCESNLPsolver_table_build(FORCESNLPsolver_table *table, const solver_int32_default *n, const FORCESNLPsolver_float *lo, const FORCESNLPsolver_float *hi, const FORCESNLPsolver_float *xfinal, solver_int32_default trajectories, solver_int32_default nthreads)
+{
+    FORCESNLPsolver_params *params;
+    FORCESNLPsolver_output *output;
+    const FORCESNLPsolver_float *zopt;
+    solver_int32_default *exitflag, *point;
+    solver_int32_default p, i, k, count, nsolved = 0;
+    FORCESNLPsolver_float z[FORCESNLPsolver_NVAR];
+
+    memset(table, 0, sizeof(FORCESNLPsolver_table));
+    for( i=0; i<4; i++ )
+    {
+        table->n[i] = n[i] > 2 ? n[i] : 2;
+        table->lo[i] = lo[i];
+        table->hi[i] = hi[i];
+    }
+    table->xfinal[0] = xfinal[0];
+    table->xfinal[1] = xfinal[1];
+    table->spread = FORCESNLPsolver_TABLE_SPREAD;
+    if( allocate(table, trajectories) )
+    {
+        return FORCESNLPsolver_NOMEMORY;
+    }
+
+    params = (FORCESNLPsolver_params *)malloc(BUILD_CHUNK*sizeof(FORCESNLPsolver_params));
+    output = (FORCESNLPsolver_output *)malloc(BUILD_CHUNK*sizeof(FORCESNLPsolver_output));
+    exitflag = (solver_int32_default *)malloc(BUILD_CHUNK*sizeof(solver_int32_default));
+    point = (solver_int32_default *)malloc(BUILD_CHUNK*sizeof(solver_int32_default));
+    if( params == NULL || output == NULL || exitflag == NULL || point == NULL )
+    {
+        free(params);
+        free(output);
+        free(exitflag);
+        free(point);
+        FORCESNLPsolver_table_free(table);
+        return FORCESNLPsolver_NOMEMORY;
+    }
+
+    for( p=0; p<table->npoints; )
+    {
+        /* next chunk of grid points, skipping infeasible initial states */
+        for( count=0; count<BUILD_CHUNK && p<table->npoints; p++ )
+        {
+            z[0] = 0;
+            z[1] = 0;
+            grid_point(table, p, z + 2);
+            if( !inequalities_hold(z) )
+            {
+                continue;
+            }
+
+            /* cold start from the middle of the bounds */
+            for( k=0; k<FORCESNLPsolver_N; k++ )
+            {
+                for( i=0; i<FORCESNLPsolver_NVAR; i++ )
+                {
+                    params[count].x0[k*FORCESNLPsolver_NVAR + i] = FORCESNLPsolver_lb[i] + 0.5*(FORCESNLPsolver_ub[i] - FORCESNLPsolver_lb[i]);
+                }
+            }
+            memcpy(params[count].xinit, z + 2, 4*sizeof(FORCESNLPsolver_float));
+            memcpy(params[count].xfinal, xfinal, 2*sizeof(FORCESNLPsolver_float));
+            point[count++] = p;
+        }
+
+        if( count > 0 )
+        {
+            FORCESNLPsolver_solve_batch(count, params, output, exitflag, NULL, nthreads, NULL);
+        }
+
+        for( i=0; i<count; i++ )
+        {
+            if( exitflag[i] != FORCESNLPsolver_OPTIMAL )
+            {
+                continue;
+            }
+
+            /* the stage vectors x001..x100 of the output follow each other */
+            zopt = output[i].x001;
+            table->status[point[i]] = 1;
+            table->u[2*point[i]] = (float)zopt[0];
+            table->u[2*point[i] + 1] = (float)zopt[1];
+            if( table->x )
+            {
+                for( k=0; k<FORCESNLPsolver_N*FORCESNLPsolver_NVAR; k++ )
+                {
+                    table->x[point[i]*FORCESNLPsolver_N*FORCESNLPsolver_NVAR + k] = (float)zopt[k];
+                }
+            }
+            nsolved++;
+        }
+    }
+
+    free(params);
+    free(output);
+    free(exitflag);
+    free(point);
+    return nsolved;
+}
+
+/* frees the memory of a table */
+extern void FORCESNLPsolver_table_free(FORCESNLPsolver_table *table)
+{
+    free(table->status);
+    free(table->u);
+    free(table->x);
+    table->status = NULL;
+    table->u = NULL;
+    table->x = NULL;
+    table->npoints = 0;
+}
+
+/* interpolated solution */
+extern solver_int32_default FORCESNLPsolver_table_lookup(const FORCESNLPsolver_table *table, const FORCESNLPsolver_float *xinit, FORCESNLPsolver_float *u, FORCESNLPsolver_output *output)
+{
+    FORCESNLPsolver_float t[4], w[16], s;
+    solver_int32_default cell[4], corner[16];
+    solver_int32_default i, c, k, fallback = 0;
+    const float *x;
+    FORCESNLPsolver_float *z;
+
+    /* cell of xinit and its position in the cell */
+    for( i=0; i<4; i++ )
+    {
+        s = (xinit[i] - table->lo[i])/(table->hi[i] - table->lo[i])*(table->n[i] - 1);
+        if( !(s >= 0 && s <= table->n[i] - 1) )
+        {
+            return 1;
+        }
+        cell[i] = (solver_int32_default)s < table->n[i] - 2 ? (solver_int32_default)s : table->n[i] - 2;
+        t[i] = s - cell[i];
+    }
+
+    /* corners and multilinear weights */
+    u[0] = 0;
+    u[1] = 0;
+    for( c=0; c<16; c++ )
+    {
+        corner[c] = 0;
+        w[c] = 1;
+        for( i=3; i>=0; i-- )
+        {
+            k = (c >> i) & 1;
+            corner[c] = corner[c]*table->n[i] + cell[i] + k;
+            w[c] *= k ? t[i] : 1 - t[i];
+        }
+        fallback |= w[c] > 0 && !table->status[corner[c]];
+        u[0] += w[c]*table->u[2*corner[c]];
+        u[1] += w[c]*table->u[2*corner[c] + 1];
+    }
+
+    /* corners that disagree */
+    for( c=0; c<16; c++ )
+    {
+        if( w[c] > 0 && table->spread > 0 )
+        {
+            fallback |= fabs(table->u[2*corner[c]] - u[0]) > table->spread*(FORCESNLPsolver_ub[0] - FORCESNLPsolver_lb[0])
+                     || fabs(table->u[2*corner[c] + 1] - u[1]) > table->spread*(FORCESNLPsolver_ub[1] - FORCESNLPsolver_lb[1]);
+        }
+    }
+
+    if( output && table->x )
+    {
+        z = output->x001;
+        memset(output, 0, sizeof(FORCESNLPsolver_output));
+        for( c=0; c<16; c++ )
+        {
+            if( w[c] == 0 )
+            {
+                continue;
+            }
+            x = table->x + corner[c]*FORCESNLPsolver_N*FORCESNLPsolver_NVAR;
+            for( k=0; k<FORCESNLPsolver_N*FORCESNLPsolver_NVAR; k++ )
+            {
+                z[k] += w[c]*x[k];
+            }
+        }
+
+        /* the bounds are convex, h is not */
+        for( k=0; k<FORCESNLPsolver_N && !fallback; k++ )
+        {
+            fallback |= !inequalities_hold(z + k*FORCESNLPsolver_NVAR);
+        }
+    }
+    return fallback;
+}
+
+/* writes a table to a file */
+extern solver_int32_default FORCESNLPsolver_table_save(const FORCESNLPsolver_table *table, const char *path)
+{
+    file_header header;
+    FILE *fp;
+    size_t nx = table->x ? FORCESNLPsolver_N*FORCESNLPsolver_NVAR : 0;
+    solver_int32_default ok;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, file_magic, sizeof(header.magic));
+    memcpy(header.n, table->n, sizeof(header.n));
+    memcpy(header.lo, table->lo, sizeof(header.lo));
+    memcpy(header.hi, table->hi, sizeof(header.hi));
+    memcpy(header.xfinal, table->xfinal, sizeof(header.xfinal));
+    header.nx = (solver_int32_default)nx;
+    header.spread = table->spread;
+
+    fp = fopen(path, "wb");
+    if( fp == NULL )
+    {
+        return -1;
+    }
+    ok = fwrite(&header, sizeof(header), 1, fp) == 1
+      && fwrite(table->status, 1, table->npoints, fp) == (size_t)table->npoints
+      && fwrite(table->u, sizeof(float), 2*table->npoints, fp) == (size_t)(2*table->npoints)
+      && (nx == 0 || fwrite(table->x, sizeof(float)*nx, table->npoints, fp) == (size_t)table->npoints);
+    if( fclose(fp) != 0 || !ok )
+    {
+        return -1;
+    }
+    return 0;
+}
+
+/* reads a table from a file */
+extern solver_int32_default FORCESNLPsolver_table_load(FORCESNLPsolver_table *table, const char *path)
+{
+    file_header header;
+    FILE *fp;
+    solver_int32_default ok, i;
+
+    memset(table, 0, sizeof(FORCESNLPsolver_table));
+    fp = fopen(path, "rb");
+    if( fp == NULL )
+    {
+        return -1;
+    }
+    ok = fread(&header, sizeof(header), 1, fp) == 1
+      && memcmp(header.magic, file_magic, sizeof(header.magic)) == 0
+      && (header.nx == 0 || header.nx == FORCESNLPsolver_N*FORCESNLPsolver_NVAR);
+    for( i=0; ok && i<4; i++ )
+    {
+        ok = header.n[i] >= 2;
+    }
+    if( !ok )
+    {
+        fclose(fp);
+        return -1;
+    }
+    memcpy(table->n, header.n, sizeof(table->n));
+    memcpy(table->lo, header.lo, sizeof(table->lo));
+    memcpy(table->hi, header.hi, sizeof(table->hi));
+    memcpy(table->xfinal, header.xfinal, sizeof(table->xfinal));
+    table->spread = header.spread;
+    if( allocate(table, header.nx > 0) )
+    {
+        fclose(fp);
+        return FORCESNLPsolver_NOMEMORY;
+    }
+    ok = fread(table->status, 1, table->npoints, fp) == (size_t)table->npoints
+      && fread(table->u, sizeof(float), 2*table->npoints, fp) == (size_t)(2*table->npoints)
+      && (header.nx == 0 || fread(table->x, sizeof(float)*header.nx, table->npoints, fp) == (size_t)table->npoints);
+    fclose(fp);
+    if( !ok )
+    {
+        FORCESNLPsolver_table_free(table);
+        return -1;
+    }
+    return 0;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
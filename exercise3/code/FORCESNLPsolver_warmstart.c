@@ -0,0 +1,562 @@
+/*
+ * Warm start database: stores converged trajectories keyed by the
+ * parameters they were solved for (xinit and xfinal) and returns the
+ * trajectory of the nearest key, or a blend of the k nearest, as initial
+ * guess of a new solve.
+ *
+ * Keys are scaled by the ranges of the variable bounds, so that distances
+ * weigh all components alike. Lookups use a kd-tree over the entries.
+ * Entries added after the tree was built are kept in a pending list that
+ * is searched linearly until it is large enough to rebuild the tree. A
+ * full database replaces its least recently used entry.
+ *
+ * A database saved to disk is memory-mapped when loaded (read into memory
+ * on Windows or if mapping fails), so loading is cheap and only the
+ * trajectories actually used are paged in. The entries are copied to the
+ * heap on the first insert.
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+/* most neighbours blended by one lookup */
+#define MAX_NEIGHBOURS  (16)
+
+/* smallest number of pending entries that triggers a rebuild of the tree,
+ * smaller databases are rebuilt once all their entries are pending */
+#define MIN_PENDING     (64)
+
+/* file header, followed by count entries */
+typedef struct file_header
+{
+    char magic[8];
+    solver_int32_default nkey;
+    solver_int32_default nx;
+    solver_int32_default size;
+    solver_int32_default reserved;
+    solver_int64_default count;
+} file_header;
+
+static const char file_magic[8] = "FNLPWS1";
+
+/* kd-tree node: entry in slot, split value and version of the entry when
+ * the tree was built, entries replaced since are skipped */
+struct FORCESNLPsolver_warmstart_node
+{
+    solver_int32_default slot;
+    solver_int32_default version;
+    FORCESNLPsolver_float split;
+};
+typedef struct FORCESNLPsolver_warmstart_node node;
+
+/* k nearest entries found so far, sorted by distance */
+typedef struct neighbours
+{
+    solver_int32_default k;
+    solver_int32_default n;
+    solver_int32_default slot[MAX_NEIGHBOURS];
+    FORCESNLPsolver_float dist[MAX_NEIGHBOURS];
+} neighbours;
+
+/* scaled key of a problem */
+static void make_key(const FORCESNLPsolver_params *params, FORCESNLPsolver_float *key)
+{
+    solver_int32_default i;
+
+    for( i=0; i<4; i++ )
+    {
+        key[i] = params->xinit[i] / (FORCESNLPsolver_ub[2 + i] - FORCESNLPsolver_lb[2 + i]);
+    }
+    for( i=0; i<2; i++ )
+    {
+        key[4 + i] = params->xfinal[i] / (FORCESNLPsolver_ub[4 + i] - FORCESNLPsolver_lb[4 + i]);
+    }
+}
+
+static FORCESNLPsolver_float distance(const FORCESNLPsolver_float *a, const FORCESNLPsolver_float *b)
+{
+    FORCESNLPsolver_float d = 0;
+    solver_int32_default i;
+
+    for( i=0; i<FORCESNLPsolver_WARMSTART_NKEY; i++ )
+    {
+        d += (a[i] - b[i])*(a[i] - b[i]);
+    }
+    return sqrt(d);
+}
+
+/* adds a candidate to the k nearest */
+static void consider(neighbours *nb, solver_int32_default slot, FORCESNLPsolver_float d)
+{
+    solver_int32_default i;
+
+    if( nb->n == nb->k && d >= nb->dist[nb->n - 1] )
+    {
+        return;
+    }
+    i = nb->n < nb->k ? nb->n++ : nb->n - 1;
+    for( ; i>0 && nb->dist[i - 1] > d; i-- )
+    {
+        nb->slot[i] = nb->slot[i - 1];
+        nb->dist[i] = nb->dist[i - 1];
+    }
+    nb->slot[i] = slot;
+    nb->dist[i] = d;
+}
+
+/* distance beyond which no candidate can improve the k nearest */
+static FORCESNLPsolver_float search_radius(const neighbours *nb)
+{
+    return nb->n < nb->k ? HUGE_VAL : nb->dist[nb->n - 1];
+}
+
+/* orders tree[lo..hi) such that the median along dim is at the middle */
+static void select_median(FORCESNLPsolver_warmstart *db, node *tree, solver_int32_default lo, solver_int32_default hi, solver_int32_default dim)
+{
+    solver_int32_default mid = lo + (hi - lo)/2;
+    solver_int32_default i, last;
+    FORCESNLPsolver_float pivot;
+    node t;
+
+    while( hi - lo > 1 )
+    {
+        /* Lomuto partition around the middle element */
+        t = tree[mid]; tree[mid] = tree[hi - 1]; tree[hi - 1] = t;
+        pivot = db->entries[tree[hi - 1].slot].key[dim];
+        last = lo;
+        for( i=lo; i<hi - 1; i++ )
+        {
+            if( db->entries[tree[i].slot].key[dim] < pivot )
+            {
+                t = tree[i]; tree[i] = tree[last]; tree[last] = t;
+                last++;
+            }
+        }
+        t = tree[last]; tree[last] = tree[hi - 1]; tree[hi - 1] = t;
+
+        if( last == mid )
+        {
+            break;
+        }
+        if( last < mid )
+        {
+            lo = last + 1;
+        }
+        else
+        {
+            hi = last;
+        }
+    }
+}
+
+static void build(FORCESNLPsolver_warmstart *db, solver_int32_default lo, solver_int32_default hi, solver_int32_default depth)
+{
+    solver_int32_default dim = depth % FORCESNLPsolver_WARMSTART_NKEY;
+    solver_int32_default mid = lo + (hi - lo)/2;
+
+    if( hi <= lo )
+    {
+        return;
+    }
+    select_median(db, db->tree, lo, hi, dim);
+    db->tree[mid].split = db->entries[db->tree[mid].slot].key[dim];
+    build(db, lo, mid, depth + 1);
+    build(db, mid + 1, hi, depth + 1);
+}
+
+/* rebuilds the tree over all entries */
+static void rebuild(FORCESNLPsolver_warmstart *db)
+{
+    solver_int32_default i;
+
+    for( i=0; i<db->count; i++ )
+    {
+        db->tree[i].slot = i;
+        db->tree[i].version = db->version[i];
+    }
+    build(db, 0, db->count, 0);
+    db->ntree = db->count;
+    db->npending = 0;
+}
+
+static void search(const FORCESNLPsolver_warmstart *db, const FORCESNLPsolver_float *key, solver_int32_default lo, solver_int32_default hi, solver_int32_default depth, neighbours *nb)
+{
+    solver_int32_default dim = depth % FORCESNLPsolver_WARMSTART_NKEY;
+    solver_int32_default mid = lo + (hi - lo)/2;
+    const node *n = db->tree + mid;
+    FORCESNLPsolver_float side;
+
+    if( hi <= lo )
+    {
+        return;
+    }
+    if( db->version[n->slot] == n->version )
+    {
+        consider(nb, n->slot, distance(key, db->entries[n->slot].key));
+    }
+
+    /* near side first, far side only if it can hold a closer entry */
+    side = key[dim] - n->split;
+    if( side < 0 )
+    {
+        search(db, key, lo, mid, depth + 1, nb);
+        if( -side < search_radius(nb) )
+        {
+            search(db, key, mid + 1, hi, depth + 1, nb);
+        }
+    }
+    else
+    {
+        search(db, key, mid + 1, hi, depth + 1, nb);
+        if( side < search_radius(nb) )
+        {
+            search(db, key, lo, mid, depth + 1, nb);
+        }
+    }
+}
+
+/* releases a mapped or loaded file */
+static void release_file(FORCESNLPsolver_warmstart *db)
+{
+    if( db->map == NULL )
+    {
+        return;
+    }
+#if !defined(_WIN32)
+    if( db->maplength > 0 )
+    {
+        munmap(db->map, db->maplength);
+    }
+    else
+#endif
+    {
+        free(db->map);
+    }
+    db->map = NULL;
+    db->maplength = 0;
+}
+
+/* moves the entries of a loaded file to writable heap memory */
+static solver_int32_default make_writable(FORCESNLPsolver_warmstart *db)
+{
+    FORCESNLPsolver_warmstart_entry *entries;
+
+    if( db->writable )
+    {
+        return 0;
+    }
+    entries = (FORCESNLPsolver_warmstart_entry *)malloc(db->capacity*sizeof(FORCESNLPsolver_warmstart_entry));
+    if( entries == NULL )
+    {
+        return FORCESNLPsolver_NOMEMORY;
+    }
+    if( db->count > 0 )
+    {
+        memcpy(entries, db->entries, db->count*sizeof(FORCESNLPsolver_warmstart_entry));
+    }
+    release_file(db);
+    db->entries = entries;
+    db->writable = 1;
+    return 0;
+}
+
+/* prepares an empty database */
+extern solver_int32_default FORCESNLPsolver_warmstart_init(FORCESNLPsolver_warmstart *db, solver_int32_default capacity)
+{
+    memset(db, 0, sizeof(FORCESNLPsolver_warmstart));
+    db->capacity = capacity > 0 ? capacity : 1;
+    db->radius = FORCESNLPsolver_WARMSTART_RADIUS;
+    db->used = (solver_int64_default *)calloc(db->capacity, sizeof(solver_int64_default));
+    db->version = (solver_int32_default *)calloc(db->capacity, sizeof(solver_int32_default));
+    db->pending = (solver_int32_default *)malloc(db->capacity*sizeof(solver_int32_default));
+    db->tree = (node *)malloc(db->capacity*sizeof(node));
+    if( db->used == NULL || db->version == NULL || db->pending == NULL || db->tree == NULL )
+    {
+        FORCESNLPsolver_warmstart_free(db);
+        return FORCESNLPsolver_NOMEMORY;
+    }
+    return 0;
+}
+
+/* frees a database */
+extern void FORCESNLPsolver_warmstart_free(FORCESNLPsolver_warmstart *db)
+{
+    release_file(db);
+    if( db->writable )
+    {
+        free(db->entries);
+    }
+    free(db->used);
+    free(db->version);
+    free(db->pending);
+    free(db->tree);
+    memset(db, 0, sizeof(FORCESNLPsolver_warmstart));
+}
+
+/* stores a solution */
+extern solver_int32_default FORCESNLPsolver_warmstart_insert(FORCESNLPsolver_warmstart *db, const FORCESNLPsolver_params *params, const FORCESNLPsolver_output *output)
+{
+    FORCESNLPsolver_float key[FORCESNLPsolver_WARMSTART_NKEY];
+    neighbours nb;
+    solver_int32_default slot, i, pending;
+
+    if( make_writable(db) )
+    {
+        return FORCESNLPsolver_NOMEMORY;
+    }
+    make_key(params, key);
+
+    /* the same key again updates its entry */
+    nb.k = 1;
+    nb.n = 0;
+    search(db, key, 0, db->ntree, 0, &nb);
+    for( i=0; i<db->npending; i++ )
+    {
+        consider(&nb, db->pending[i], distance(key, db->entries[db->pending[i]].key));
+    }
+    if( nb.n > 0 && nb.dist[0] == 0 )
+    {
+        slot = nb.slot[0];
+        memcpy(db->entries[slot].x, output, sizeof(db->entries[slot].x));
+        db->used[slot] = ++db->clock;
+        return slot;
+    }
+
+    pending = 0;
+    if( db->count < db->capacity )
+    {
+        slot = db->count++;
+    }
+    else
+    {
+        /* replace the least recently used entry, its tree node goes stale */
+        slot = 0;
+        for( i=1; i<db->count; i++ )
+        {
+            slot = db->used[i] < db->used[slot] ? i : slot;
+        }
+        db->version[slot]++;
+
+        /* an entry stored since the last rebuild is pending already */
+        for( i=0; i<db->npending && !pending; i++ )
+        {
+            pending = db->pending[i] == slot;
+        }
+    }
+    memcpy(db->entries[slot].key, key, sizeof(key));
+    memcpy(db->entries[slot].x, output, sizeof(db->entries[slot].x));
+    db->used[slot] = ++db->clock;
+    if( !pending )
+    {
+        /* every slot is pending at most once, so npending <= capacity */
+        db->pending[db->npending++] = slot;
+    }
+
+    if( (db->npending >= MIN_PENDING && db->npending*8 >= db->count) || db->npending == db->capacity )
+    {
+        rebuild(db);
+    }
+    return slot;
+}
+
+/* initial guess from the nearest stored solutions */
+extern solver_int32_default FORCESNLPsolver_warmstart_lookup(FORCESNLPsolver_warmstart *db, FORCESNLPsolver_params *params, solver_int32_default k)
+{
+    FORCESNLPsolver_float key[FORCESNLPsolver_WARMSTART_NKEY];
+    FORCESNLPsolver_float w[MAX_NEIGHBOURS], wsum = 0;
+    const FORCESNLPsolver_float *x;
+    neighbours nb;
+    solver_int32_default i, j;
+
+    db->lookups++;
+    make_key(params, key);
+
+    nb.k = k < 1 ? 1 : k > MAX_NEIGHBOURS ? MAX_NEIGHBOURS : k;
+    nb.n = 0;
+    search(db, key, 0, db->ntree, 0, &nb);
+    for( i=0; i<db->npending; i++ )
+    {
+        consider(&nb, db->pending[i], distance(key, db->entries[db->pending[i]].key));
+    }
+
+    /* only neighbours within the radius are used */
+    while( nb.n > 0 && db->radius > 0 && nb.dist[nb.n - 1] > db->radius )
+    {
+        nb.n--;
+    }
+    if( nb.n == 0 )
+    {
+        return 0;
+    }
+    db->hits++;
+
+    /* an exact match is returned as is, otherwise inverse distance weights */
+    if( nb.dist[0] == 0 )
+    {
+        nb.n = 1;
+    }
+    for( i=0; i<nb.n; i++ )
+    {
+        w[i] = nb.n == 1 ? 1 : 1/nb.dist[i];
+        wsum += w[i];
+        db->used[nb.slot[i]] = ++db->clock;
+    }
+    for( j=0; j<FORCESNLPsolver_N*FORCESNLPsolver_NVAR; j++ )
+    {
+        params->x0[j] = 0;
+    }
+    for( i=0; i<nb.n; i++ )
+    {
+        x = db->entries[nb.slot[i]].x;
+        for( j=0; j<FORCESNLPsolver_N*FORCESNLPsolver_NVAR; j++ )
+        {
+            params->x0[j] += w[i]/wsum*x[j];
+        }
+    }
+    return nb.n;
+}
+
+/* writes a database to a file */
+extern solver_int32_default FORCESNLPsolver_warmstart_save(const FORCESNLPsolver_warmstart *db, const char *path)
+{
+    file_header header;
+    FILE *fp;
+    size_t written;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, file_magic, sizeof(header.magic));
+    header.nkey = FORCESNLPsolver_WARMSTART_NKEY;
+    header.nx = FORCESNLPsolver_N*FORCESNLPsolver_NVAR;
+    header.size = sizeof(FORCESNLPsolver_float);
+    header.count = db->count;
+
+    fp = fopen(path, "wb");
+    if( fp == NULL )
+    {
+        return -1;
+    }
+    written = fwrite(&header, sizeof(header), 1, fp);
+    if( db->count > 0 )
+    {
+        written += fwrite(db->entries, sizeof(FORCESNLPsolver_warmstart_entry), db->count, fp);
+    }
+    if( fclose(fp) != 0 || written != (size_t)db->count + 1 )
+    {
+        return -1;
+    }
+    return 0;
+}
+
+/* loads a database from a file */
+extern solver_int32_default FORCESNLPsolver_warmstart_load(FORCESNLPsolver_warmstart *db, const char *path)
+{
+    file_header header;
+    FILE *fp;
+    void *data = NULL;
+    size_t length, maplength = 0;
+    solver_int32_default count, i;
+
+    /* the file is checked and read completely before the database changes */
+    fp = fopen(path, "rb");
+    if( fp == NULL )
+    {
+        return -1;
+    }
+    if( fread(&header, sizeof(header), 1, fp) != 1
+        || memcmp(header.magic, file_magic, sizeof(header.magic)) != 0
+        || header.nkey != FORCESNLPsolver_WARMSTART_NKEY
+        || header.nx != FORCESNLPsolver_N*FORCESNLPsolver_NVAR
+        || header.size != (solver_int32_default)sizeof(FORCESNLPsolver_float)
+        || header.count < 0 )
+    {
+        fclose(fp);
+        return -1;
+    }
+    count = header.count < db->capacity ? (solver_int32_default)header.count : db->capacity;
+    length = sizeof(header) + count*sizeof(FORCESNLPsolver_warmstart_entry);
+
+#if !defined(_WIN32)
+    {
+        struct stat st;
+
+        /* a truncated file is read below, which detects the short read */
+        if( fstat(fileno(fp), &st) == 0 && (size_t)st.st_size >= length )
+        {
+            data = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+            if( data == MAP_FAILED )
+            {
+                data = NULL;
+            }
+            else
+            {
+                maplength = length;
+            }
+        }
+    }
+#endif
+    if( data == NULL )
+    {
+        /* read the entries instead */
+        data = malloc(length);
+        if( data == NULL )
+        {
+            fclose(fp);
+            return FORCESNLPsolver_NOMEMORY;
+        }
+        if( fread((char *)data + sizeof(header), sizeof(FORCESNLPsolver_warmstart_entry), count, fp) != (size_t)count )
+        {
+            free(data);
+            fclose(fp);
+            return -1;
+        }
+    }
+    fclose(fp);
+
+    /* only now the old entries are released */
+    release_file(db);
+    if( db->writable )
+    {
+        free(db->entries);
+        db->writable = 0;
+    }
+    db->map = data;
+    db->maplength = maplength;
+    db->entries = (FORCESNLPsolver_warmstart_entry *)((char *)data + sizeof(header));
+    db->count = count;
+    for( i=0; i<count; i++ )
+    {
+        db->used[i] = 0;
+        db->version[i] = 0;
+    }
+    rebuild(db);
+    return 0;
+}
+
+/* lookup statistics */
+extern void FORCESNLPsolver_warmstart_stats(const FORCESNLPsolver_warmstart *db, solver_int64_default *lookups, solver_int64_default *hits)
+{
+    *lookups = db->lookups;
+    *hits = db->hits;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -114,6 +114,8 @@ codeoptions.maxit = 200;    % Maximum number of iterations
 codeoptions.printlevel = 2; % Use printlevel = 2 to print progress (but not for timings)
 codeoptions.optlevel = 0; % 2: optimize for speed
 codeoptions.cleanup = 0;
+% codeoptions.threadSafeStorage = 1; % concurrent solves of different contexts, compile with -DFORCESNLPsolver_THREADSAFE_STORAGE=1
+% codeoptions.nlp.hessian_approximation = 'none'; % exact Hessian, compile FORCESNLPsolver_casadi2forces.c with -DFORCESNLPsolver_EXACT_HESSIAN=1
 
 %% Generate forces solver
 FORCES_NLP(model, codeoptions);
@@ -129,6 +131,7 @@ problem.x0=x0;
 problem.xinit = model.xinit;
 problem.xfinal = model.xfinal;
 problem.all_parameters = [5; 10];
+problem.stacked = 1; % return the stages as one 6 x N matrix (MEX built from FORCESNLPsolver_mex.c)
 
 % Time to solve the NLP!
 [output,exitflag,info] = FORCESNLPsolver(problem);
@@ -147,9 +150,16 @@ colorGrey = 0.8*[1, 1, 1]; % grey, used for plotting
 colorWhite = [1, 1, 1];
 pathFig = [pwd, filesep, 'fig' filesep];
 
-TEMP = zeros(model.nvar,model.N);
-for i=1:model.N
-    TEMP(:,i) = output.(['x',sprintf('%02d',i)]);
+if isstruct(output)
+    % MEX generated by FORCES_NLP, which ignores problem.stacked and pads
+    % the stage numbers of the field names to the digits of model.N
+    fieldFormat = sprintf('x%%0%dd', numel(num2str(model.N)));
+    TEMP = zeros(model.nvar,model.N);
+    for i=1:model.N
+        TEMP(:,i) = output.(sprintf(fieldFormat,i));
+    end
+else
+    TEMP = output(:,1:model.N);
 end
 U = TEMP(1:2,:);
 X = TEMP(3:6,:);
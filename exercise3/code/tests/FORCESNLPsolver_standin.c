@@ -0,0 +1,18 @@
+/*
+ * Stand-in for FORCESNLPsolver_solve, so that the tests link where the
+ * generated solver library is not available (it is shipped for Windows
+ * only). The tests do not solve; a call returns the initial guess.
+ */
+
+#include <string.h>
+
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+extern solver_int32_default FORCESNLPsolver_solve(FORCESNLPsolver_params *params, FORCESNLPsolver_output *output, FORCESNLPsolver_info *info, FILE *fs, FORCESNLPsolver_extfunc FORCESNLPsolver_evalextfunctions)
+{
+    (void)fs;
+    (void)FORCESNLPsolver_evalextfunctions;
+    memcpy(output, params->x0, sizeof(FORCESNLPsolver_output));
+    memset(info, 0, sizeof(FORCESNLPsolver_info));
+    return FORCESNLPsolver_NOPROGRESS;
+}
@@ -0,0 +1,109 @@
+/*
+ * Exact Hessian: the 18 nonzeros of FORCESNLPsolver_model_1_hess against
+ * central differences of the gradient of the stage Lagrangian
+ * f + y'*c + l'*h, assembled from the dense outputs of
+ * FORCESNLPsolver_casadi2forces. Built with FORCESNLPsolver_EXACT_HESSIAN.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+#define NVAR FORCESNLPsolver_NVAR
+#define NEQ FORCESNLPsolver_NEQ
+#define NH FORCESNLPsolver_NH
+
+/* finite difference step and tolerance relative to the entry */
+#define DELTA (1e-6)
+#define TOL (1e-6)
+
+static int failures = 0;
+
+#define CHECK(cond) do { if( !(cond) ) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while( 0 )
+
+/* gradient of the Lagrangian of a stage at z, the Jacobians are column
+ * major with one row per constraint */
+static void gradient(double *z, double *y, double *l, int stage, double *g)
+{
+    double f = 0, nabla_f[NVAR], c[NEQ], nabla_c[NEQ*NVAR], h[NH], nabla_h[NH*NVAR];
+    int i, j;
+
+    memset(nabla_f, 0, sizeof(nabla_f));
+    memset(nabla_c, 0, sizeof(nabla_c));
+    memset(nabla_h, 0, sizeof(nabla_h));
+    FORCESNLPsolver_casadi2forces(z, y, l, NULL, &f, nabla_f, c, nabla_c, h, nabla_h, NULL, stage);
+    for( j=0; j<NVAR; j++ )
+    {
+        g[j] = nabla_f[j];
+        for( i=0; stage < FORCESNLPsolver_N - 1 && i<NEQ; i++ )
+        {
+            g[j] += y[i]*nabla_c[i + NEQ*j];
+        }
+        for( i=0; i<NH; i++ )
+        {
+            g[j] += l[i]*nabla_h[i + NH*j];
+        }
+    }
+}
+
+/* compares the Hessian of a stage at z with differences of its gradient 
+ * and counts its nonzeros */
+static void check_stage(double *z, double *y, double *l, int stage, int nonzeros)
+{
+    double hess[NVAR*NVAR], fd, gp[NVAR], gm[NVAR], zj;
+    int i, j, nnz = 0;
+
+    memset(hess, 0, sizeof(hess));
+    FORCESNLPsolver_casadi2forces(z, y, l, NULL, NULL, NULL, NULL, NULL, NULL, NULL, hess, stage);
+    for( j=0; j<NVAR; j++ )
+    {
+        zj = z[j];
+        z[j] = zj + DELTA;
+        gradient(z, y, l, stage, gp);
+        z[j] = zj - DELTA;
+        gradient(z, y, l, stage, gm);
+        z[j] = zj;
+        for( i=0; i<NVAR; i++ )
+        {
+            fd = (gp[i] - gm[i]) / (2*DELTA);
+            if( fabs(hess[i + NVAR*j] - fd) > TOL*(1 + fabs(fd)) )
+            {
+                printf("stage %d: hess(%d,%d) = %.9g, finite difference %.9g\n", stage, i, j, hess[i + NVAR*j], fd);
+                failures++;
+            }
+            CHECK(hess[i + NVAR*j] == hess[j + NVAR*i]);
+            nnz += hess[i + NVAR*j] != 0;
+        }
+    }
+
+    CHECK(nnz == nonzeros);
+}
+
+int main(void)
+{
+    /* generic point beside the obstacle with all multipliers nonzero */
+    double z[NVAR] = {0.7, -0.3, -1.1, 1.6, 1.3, 0.9};
+    double y[NEQ] = {0.8, -1.7, 0.4, 1.2};
+    double l[NH] = {0.6, 2.3};
+
+    /* all 18 structural nonzeros at a generic point; the terminal stage 
+     * has no dynamics, only F and s of the objective and x and y of the 
+     * inequalities remain */
+    check_stage(z, y, l, 10, 18);
+    check_stage(z, y, l, FORCESNLPsolver_N - 1, 4);
+
+    /* weights other than the generated ones */
+    FORCESNLPsolver_context_set_weights(FORCESNLPsolver_context_current(), 50, 0.3, 0.05);
+    check_stage(z, y, l, 10, 18);
+    check_stage(z, y, l, FORCESNLPsolver_N - 1, 4);
+
+    if( failures > 0 )
+    {
+        printf("test_hessian: %d failures\n", failures);
+        return 1;
+    }
+    printf("test_hessian: passed\n");
+    return 0;
+}
@@ -0,0 +1,134 @@
+/*
+ * SIMD stage kernel: the outputs of FORCESNLPsolver_casadi2forces_allstages,
+ * which evaluates FORCESNLPsolver_SIMD_WIDTH stages per kernel call, against
+ * FORCESNLPsolver_casadi2forces evaluating the same stages one at a time
+ * with the scalar CasADi kernel. Built once per SIMD width the header can
+ * select, in double and in single precision.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+#define N FORCESNLPsolver_N
+#define NVAR FORCESNLPsolver_NVAR
+#define NEQ FORCESNLPsolver_NEQ
+#define NH FORCESNLPsolver_NH
+
+/* tolerance relative to the entry, the two kernels round differently */
+#ifdef FORCESNLPsolver_SINGLE_PRECISION_MODELS
+#define TOL (1e-6)
+#else
+#define TOL (1e-12)
+#endif
+
+static int failures = 0;
+
+#define CHECK(cond) do { if( !(cond) ) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while( 0 )
+
+/* outputs of all stages, stage-strided as in _allstages */
+typedef struct outputs
+{
+    double f[N];
+    double nabla_f[N*NVAR];
+    double c[N*NEQ];
+    double nabla_c[N*NEQ*NVAR];
+    double h[N*NH];
+    double nabla_h[N*NH*NVAR];
+} outputs;
+
+static outputs all, ref;
+
+/* largest relative difference seen, printed at the end */
+static double maxdiff = 0;
+
+/* compares n entries of one output */
+static void compare(const char *name, const double *a, const double *b, int n, int stride, int horizon)
+{
+    double d;
+    int i;
+
+    for( i=0; i<n; i++ )
+    {
+        d = fabs(a[i] - b[i]) / (1 + fabs(b[i]));
+        maxdiff = d > maxdiff ? d : maxdiff;
+        if( d > TOL )
+        {
+            printf("horizon %d: %s of stage %d, entry %d: %.9g, scalar kernel %.9g\n", horizon, name, i / stride, i % stride, a[i], b[i]);
+            failures++;
+        }
+    }
+}
+
+/* evaluates all stages at z both ways, only the outputs selected by
+ * derivatives: 0 values, 1 also the gradients of f and h, 2 everything.
+ * This selects the _val, _valgrad and full kernel. */
+static void check_horizon(double *z, int horizon, int derivatives)
+{
+    double *nabla_f = derivatives >= 1 ? all.nabla_f : NULL;
+    double *nabla_h = derivatives >= 1 ? all.nabla_h : NULL;
+    double *nabla_c = derivatives >= 2 ? all.nabla_c : NULL;
+    int k;
+
+    CHECK(FORCESNLPsolver_casadi2forces_set_horizon(horizon) == horizon);
+    memset(&all, 0, sizeof(all));
+    memset(&ref, 0, sizeof(ref));
+
+    FORCESNLPsolver_casadi2forces_allstages(z, NULL, NULL, NULL, all.f, nabla_f, all.c, nabla_c, all.h, nabla_h, NULL);
+    for( k=0; k<N; k++ )
+    {
+        FORCESNLPsolver_casadi2forces(z + k*NVAR, NULL, NULL, NULL, ref.f + k, nabla_f ? ref.nabla_f + k*NVAR : NULL, ref.c + k*NEQ, nabla_c ? ref.nabla_c + k*NEQ*NVAR : NULL, ref.h + k*NH, nabla_h ? ref.nabla_h + k*NH*NVAR : NULL, NULL, k);
+    }
+
+    compare("f", all.f, ref.f, N, 1, horizon);
+    compare("nabla_f", all.nabla_f, ref.nabla_f, N*NVAR, NVAR, horizon);
+    compare("c", all.c, ref.c, N*NEQ, NEQ, horizon);
+    compare("nabla_c", all.nabla_c, ref.nabla_c, N*NEQ*NVAR, NEQ*NVAR, horizon);
+    compare("h", all.h, ref.h, N*NH, NH, horizon);
+    compare("nabla_h", all.nabla_h, ref.nabla_h, N*NH*NVAR, NH*NVAR, horizon);
+}
+
+/* every kernel variant on all stages and on a horizon whose non-terminal
+ * stages do not fill the last SIMD block */
+static void check_all(double *z)
+{
+    int derivatives;
+
+    for( derivatives=0; derivatives<=2; derivatives++ )
+    {
+        check_horizon(z, N, derivatives);
+        check_horizon(z, 37, derivatives);
+    }
+}
+
+int main(void)
+{
+    /* a trajectory within the bounds with different values in every
+     * stage and lane */
+    double z[N*NVAR];
+    int k, i;
+
+    for( k=0; k<N; k++ )
+    {
+        for( i=0; i<NVAR; i++ )
+        {
+            z[k*NVAR + i] = FORCESNLPsolver_lb[i] + (FORCESNLPsolver_ub[i] - FORCESNLPsolver_lb[i])*(0.5 + 0.45*sin(1.3*k + 2.1*i + 0.7));
+        }
+    }
+
+    check_all(z);
+
+    /* weights other than the generated ones */
+    FORCESNLPsolver_context_set_weights(FORCESNLPsolver_context_current(), 50, 0.3, 0.05);
+    check_all(z);
+
+    if( failures > 0 )
+    {
+        printf("test_simd: %d failures\n", failures);
+        return 1;
+    }
+    printf("test_simd: passed, SIMD width %d, largest difference %.2g\n", FORCESNLPsolver_SIMD_WIDTH, maxdiff);
+    return 0;
+}
@@ -0,0 +1,182 @@
+/*
+ * Warm start database: LRU replacement in databases smaller than the
+ * rebuild threshold, and a failed load of a truncated file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FORCESNLPsolver/include/FORCESNLPsolver.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if( !(cond) ) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while( 0 )
+
+/* problem i with a distinct key and a trajectory that identifies it */
+static void problem(int i, FORCESNLPsolver_params *params, FORCESNLPsolver_output *output)
+{
+    FORCESNLPsolver_float *z = output->x001;
+    int j;
+
+    memset(params, 0, sizeof(*params));
+    params->xinit[0] = -0.01*i;
+    params->xinit[1] = 0.001*(i % 7);
+    params->xfinal[0] = 1;
+    params->xfinal[1] = 0.5;
+    for( j=0; j<FORCESNLPsolver_N*FORCESNLPsolver_NVAR; j++ )
+    {
+        z[j] = i + 1e-3*j;
+    }
+}
+
+/* the slots in the pending list are distinct and fit into it */
+static void check_pending(const FORCESNLPsolver_warmstart *db)
+{
+    int i, j;
+
+    CHECK(db->npending <= db->capacity);
+    for( i=0; i<db->npending; i++ )
+    {
+        for( j=0; j<i; j++ )
+        {
+            CHECK(db->pending[i] != db->pending[j]);
+        }
+    }
+}
+
+/* a lookup of problem i returns its trajectory */
+static void check_lookup(FORCESNLPsolver_warmstart *db, int i)
+{
+    FORCESNLPsolver_params params, query;
+    FORCESNLPsolver_output output;
+
+    problem(i, &params, &output);
+    query = params;
+    CHECK(FORCESNLPsolver_warmstart_lookup(db, &query, 1) == 1);
+    CHECK(memcmp(query.x0, output.x001, sizeof(query.x0)) == 0);
+}
+
+/* databases below the rebuild threshold replace entries in place */
+static void test_small_capacity(void)
+{
+    FORCESNLPsolver_warmstart db;
+    FORCESNLPsolver_params params;
+    FORCESNLPsolver_output output;
+    int i;
+
+    CHECK(FORCESNLPsolver_warmstart_init(&db, 8) == 0);
+    db.radius = 0;
+    for( i=0; i<20; i++ )
+    {
+        problem(i, &params, &output);
+        CHECK(FORCESNLPsolver_warmstart_insert(&db, &params, &output) >= 0);
+        check_pending(&db);
+    }
+    CHECK(db.count == 8);
+    for( i=12; i<20; i++ )
+    {
+        check_lookup(&db, i);
+    }
+    FORCESNLPsolver_warmstart_free(&db);
+}
+
+/* replacing entries that are still pending does not list them twice */
+static void test_replace_pending(void)
+{
+    FORCESNLPsolver_warmstart db;
+    FORCESNLPsolver_params params;
+    FORCESNLPsolver_output output;
+    int i;
+
+    CHECK(FORCESNLPsolver_warmstart_init(&db, 100) == 0);
+    db.radius = 0;
+    for( i=0; i<100; i++ )
+    {
+        problem(i, &params, &output);
+        FORCESNLPsolver_warmstart_insert(&db, &params, &output);
+    }
+
+    /* the entries in the tree, problem i in slot i, are used, so the 
+     * pending ones are replaced */
+    CHECK(db.ntree > 0 && db.npending > 0);
+    for( i=0; i<db.ntree; i++ )
+    {
+        check_lookup(&db, i);
+    }
+    for( i=100; i<160; i++ )
+    {
+        problem(i, &params, &output);
+        FORCESNLPsolver_warmstart_insert(&db, &params, &output);
+        check_pending(&db);
+    }
+    for( i=130; i<160; i++ )
+    {
+        check_lookup(&db, i);
+    }
+    FORCESNLPsolver_warmstart_free(&db);
+}
+
+/* a truncated file is rejected and the database stays usable */
+static void test_truncated_load(void)
+{
+    const char *path = "test_warmstart.db";
+    FORCESNLPsolver_warmstart db;
+    FORCESNLPsolver_params params;
+    FORCESNLPsolver_output output;
+    FILE *fp;
+    char *data;
+    long length;
+    int i;
+
+    CHECK(FORCESNLPsolver_warmstart_init(&db, 256) == 0);
+    db.radius = 0;
+    for( i=0; i<200; i++ )
+    {
+        problem(i, &params, &output);
+        FORCESNLPsolver_warmstart_insert(&db, &params, &output);
+    }
+    CHECK(FORCESNLPsolver_warmstart_save(&db, path) == 0);
+
+    /* cut the file in the middle of the entries */
+    fp = fopen(path, "rb");
+    CHECK(fp != NULL);
+    fseek(fp, 0, SEEK_END);
+    length = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    data = (char *)malloc(length);
+    CHECK(fread(data, 1, length, fp) == (size_t)length);
+    fclose(fp);
+    fp = fopen(path, "wb");
+    fwrite(data, 1, length/2, fp);
+    fclose(fp);
+    free(data);
+
+    CHECK(FORCESNLPsolver_warmstart_load(&db, path) != 0);
+    CHECK(db.count == 200);
+    for( i=0; i<200; i += 17 )
+    {
+        check_lookup(&db, i);
+    }
+    problem(200, &params, &output);
+    CHECK(FORCESNLPsolver_warmstart_insert(&db, &params, &output) >= 0);
+    check_lookup(&db, 200);
+
+    /* a complete file still loads into the same database */
+    CHECK(FORCESNLPsolver_warmstart_save(&db, path) == 0);
+    CHECK(FORCESNLPsolver_warmstart_load(&db, path) == 0);
+    CHECK(db.count == 201);
+    check_lookup(&db, 200);
+
+    FORCESNLPsolver_warmstart_free(&db);
+    remove(path);
+}
+
+int main(void)
+{
+    test_small_capacity();
+    test_replace_pending();
+    test_truncated_load();
+    printf("test_warmstart: %s\n", failures ? "FAILED" : "passed");
+    return failures != 0;
+}